@@ -0,0 +1,290 @@
+// Times BigInteger add, sub, mul, sqr, div, mod, parse and print for operands from one 32-bit
+// limb up to the decimal digit cap, and writes the results as JSON with one benchmark per line
+// so that two runs diff cleanly. With --baseline, compares against an earlier JSON file and exits
+// with status 1 when anything got slower by more than the tolerance.
+//
+//   big_integer_bench [--json=FILE|-] [--baseline=FILE] [--tolerance=0.10] [--filter=TEXT]
+//                     [--min-time=SECONDS] [--max-digits=N] [--threads=N]
+//
+// Built by the big_integer_bench CMake target; baselines live in bench/baselines.
+
+#include "big_integer.h"
+#include "big_integer_simd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+  std::string json_path;
+  std::string baseline_path;
+  std::string filter;
+  double tolerance = 0.10;
+  double min_time = 0.1;
+  size_t max_digits = BigInteger::kDefaultMaxDecimalDigits;
+  size_t threads = 1;
+};
+
+struct Result {
+  std::string operation;
+  size_t limbs;
+  double ns_per_op;
+  size_t iterations;
+
+  std::string Name() const {
+    return operation + "/" + std::to_string(limbs);
+  }
+};
+
+// Keeps results observable so that the timed calls are not optimised away.
+size_t sink = 0;
+
+// A number of exactly limbs 32-bit digits, read from its binary form.
+BigInteger RandomNumber(size_t limbs, std::mt19937& gen) {
+  std::vector<uint32_t> words(2 + limbs);
+  words[0] = static_cast<uint32_t>(limbs << 1);
+  words[1] = static_cast<uint32_t>(static_cast<uint64_t>(limbs) >> 31);
+  for (size_t i = 0; i < limbs; ++i) {
+    words[2 + i] = gen();
+  }
+  words[1 + limbs] |= 0x80000000u;
+  return BigInteger(BigIntegerView::FromBinary(words.data(), words.size() * sizeof(uint32_t)));
+}
+
+// Best time per call of body over a few rounds that together take about min_time seconds.
+template <class Body>
+Result Measure(const std::string& operation, size_t limbs, double min_time, const Body& body) {
+  const int kRounds = 5;
+  double best = std::numeric_limits<double>::max();
+  size_t total = 0;
+
+  for (int round = 0; round < kRounds; ++round) {
+    size_t iterations = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed{};
+    do {
+      body();
+      ++iterations;
+      elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed.count() < min_time / kRounds);
+    best = std::min(best, elapsed.count() / static_cast<double>(iterations));
+    total += iterations;
+  }
+
+  return {operation, limbs, best * 1e9, total};
+}
+
+// 1, 2, 4, ... limbs, and then the largest size under the decimal digit cap.
+std::vector<size_t> Sizes(size_t max_digits) {
+  size_t cap = static_cast<size_t>(static_cast<double>(max_digits) * 3.321928 / 32);
+  std::vector<size_t> sizes;
+  for (size_t limbs = 1; limbs < cap; limbs *= 2) {
+    sizes.push_back(limbs);
+  }
+  sizes.push_back(std::max<size_t>(cap, 1));
+  return sizes;
+}
+
+std::vector<Result> Run(const Options& options) {
+  std::vector<Result> results;
+  auto wanted = [&](const std::string& operation, size_t limbs) {
+    return (operation + "/" + std::to_string(limbs)).find(options.filter) != std::string::npos;
+  };
+  auto add = [&](const std::string& operation, size_t limbs, auto body) {
+    if (wanted(operation, limbs)) {
+      results.push_back(Measure(operation, limbs, options.min_time, body));
+      const Result& res = results.back();
+      std::cerr << std::left << std::setw(16) << res.Name() << std::right << std::setw(16) << std::fixed
+                << std::setprecision(1) << res.ns_per_op << " ns\n";
+    }
+  };
+
+  for (size_t limbs : Sizes(options.max_digits)) {
+    std::mt19937 gen(static_cast<uint32_t>(limbs));
+    BigInteger a = RandomNumber(limbs, gen);
+    BigInteger b = RandomNumber(limbs, gen);
+    BigInteger divisor = RandomNumber((limbs + 1) / 2, gen);
+
+    std::ostringstream text_stream;
+    text_stream << a;
+    std::string text = text_stream.str();
+    std::vector<char> buffer(text.size() + 1);
+
+    add("add", limbs, [&] {
+      sink += (a + b).IsNegative();
+    });
+    add("sub", limbs, [&] {
+      sink += (a - b).IsNegative();
+    });
+    add("mul", limbs, [&] {
+      sink += (a * b).IsNegative();
+    });
+    add("sqr", limbs, [&] {
+      sink += (a * a).IsNegative();
+    });
+    add("div", limbs, [&] {
+      sink += (a / divisor).IsNegative();
+    });
+    add("mod", limbs, [&] {
+      sink += (a % divisor).IsNegative();
+    });
+    add("parse", limbs, [&] {
+      sink += BigInteger(text).IsNegative();
+    });
+    add("print", limbs, [&] {
+      sink += static_cast<size_t>(ToChars(buffer.data(), buffer.data() + buffer.size(), a).ptr - buffer.data());
+    });
+  }
+
+  return results;
+}
+
+std::string SimdLevel() {
+  switch (big_integer_simd::ActiveLevel()) {
+    case big_integer_simd::Level::kAvx2:
+      return "avx2";
+    case big_integer_simd::Level::kSse2:
+      return "sse2";
+    case big_integer_simd::Level::kScalar:
+      break;
+  }
+  return "scalar";
+}
+
+void WriteJson(std::ostream& os, const Options& options, const std::vector<Result>& results) {
+#if defined(__clang__)
+  std::string compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+  std::string compiler = "gcc " __VERSION__;
+#else
+  std::string compiler = "unknown";
+#endif
+#ifdef NDEBUG
+  std::string build = "release";
+#else
+  std::string build = "debug";
+#endif
+
+  os << "{\n";
+  os << "  \"context\": {\"compiler\": \"" << compiler << "\", \"build\": \"" << build << "\", \"simd\": \""
+     << SimdLevel() << "\", \"threads\": " << options.threads << ", \"max_digits\": " << options.max_digits
+     << ", \"min_time\": " << options.min_time << "},\n";
+  os << "  \"benchmarks\": [\n";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result& res = results[i];
+    os << "    {\"name\": \"" << res.Name() << "\", \"operation\": \"" << res.operation << "\", \"limbs\": " << res.limbs
+       << ", \"ns_per_op\": " << std::fixed << std::setprecision(1) << res.ns_per_op
+       << ", \"iterations\": " << res.iterations << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  os << "  ]\n";
+  os << "}\n";
+}
+
+// name -> ns_per_op from a file written by WriteJson, which has one benchmark per line.
+std::map<std::string, double> ReadBaseline(const std::string& path) {
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error("cannot read " + path);
+  }
+
+  std::map<std::string, double> times;
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t name = line.find("\"name\": \"");
+    size_t time = line.find("\"ns_per_op\": ");
+    if (name == std::string::npos || time == std::string::npos) {
+      continue;
+    }
+    name += 9;
+    times[line.substr(name, line.find('"', name) - name)] = std::strtod(line.c_str() + time + 13, nullptr);
+  }
+  return times;
+}
+
+// Prints new / old time ratios; returns whether nothing is slower than the tolerance allows.
+bool Compare(const std::map<std::string, double>& baseline, const std::vector<Result>& results, double tolerance) {
+  bool ok = true;
+  std::cout << std::left << std::setw(16) << "benchmark" << std::right << std::setw(16) << "baseline ns" << std::setw(16)
+            << "current ns" << std::setw(10) << "ratio" << "\n";
+
+  for (const Result& res : results) {
+    auto it = baseline.find(res.Name());
+    if (it == baseline.end() || it->second <= 0) {
+      continue;
+    }
+    double ratio = res.ns_per_op / it->second;
+    bool regressed = ratio > 1 + tolerance;
+    ok = ok && !regressed;
+    std::cout << std::left << std::setw(16) << res.Name() << std::right << std::fixed << std::setprecision(1)
+              << std::setw(16) << it->second << std::setw(16) << res.ns_per_op << std::setw(10) << std::setprecision(3)
+              << ratio << (regressed ? "  REGRESSION" : "") << "\n";
+  }
+  return ok;
+}
+
+bool ParseOption(const std::string& arg, const std::string& name, std::string& value) {
+  std::string prefix = "--" + name + "=";
+  if (arg.compare(0, prefix.size(), prefix) != 0) {
+    return false;
+  }
+  value = arg.substr(prefix.size());
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    std::string value;
+    if (ParseOption(arg, "json", value)) {
+      options.json_path = value;
+    } else if (ParseOption(arg, "baseline", value)) {
+      options.baseline_path = value;
+    } else if (ParseOption(arg, "filter", value)) {
+      options.filter = value;
+    } else if (ParseOption(arg, "tolerance", value)) {
+      options.tolerance = std::stod(value);
+    } else if (ParseOption(arg, "min-time", value)) {
+      options.min_time = std::stod(value);
+    } else if (ParseOption(arg, "max-digits", value)) {
+      options.max_digits = std::stoul(value);
+    } else if (ParseOption(arg, "threads", value)) {
+      options.threads = std::stoul(value);
+    } else {
+      std::cerr << "unknown argument " << arg << "\n";
+      return 2;
+    }
+  }
+
+  // Sizes run up to the cap; lift it so that products of the largest operands fit.
+  BigInteger::SetMaxDecimalDigits(BigInteger::kUnlimitedDecimalDigits);
+  BigInteger::SetMultiplicationThreads(options.threads);
+
+  std::vector<Result> results = Run(options);
+
+  if (options.json_path == "-") {
+    WriteJson(std::cout, options, results);
+  } else if (!options.json_path.empty()) {
+    std::ofstream out(options.json_path);
+    WriteJson(out, options, results);
+  }
+
+  if (!options.baseline_path.empty()) {
+    return Compare(ReadBaseline(options.baseline_path), results, options.tolerance) ? 0 : 1;
+  }
+  return sink == std::numeric_limits<size_t>::max() ? 1 : 0;
+}
@@ -0,0 +1,100 @@
+// Measures the schoolbook/Karatsuba, Karatsuba/Toom-3 and Toom-3/NTT crossovers of
+// BigInteger::operator*= and prints thresholds suitable for BigInteger::SetMultiplicationThresholds.
+//
+//   Built by the multiplication_bench CMake target.
+
+#include "big_integer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+
+namespace {
+
+const size_t kNoThreshold = std::numeric_limits<size_t>::max();
+
+// 2^(32 * digits).
+BigInteger DigitPower(size_t digits) {
+  if (digits == 1) {
+    return BigInteger(int64_t{1} << 32);
+  }
+  BigInteger half = DigitPower(digits / 2);
+  return digits % 2 == 0 ? half * half : half * half * DigitPower(1);
+}
+
+// A number of exactly the given number of 32-bit digits. Built by halves so that setting up
+// large operands does not go through quadratic decimal parsing.
+BigInteger RandomNumber(size_t digits, std::mt19937& gen) {
+  if (digits == 1) {
+    return BigInteger(static_cast<int64_t>(gen() | 0x80000000u));
+  }
+  size_t low = digits / 2;
+  return RandomNumber(digits - low, gen) * DigitPower(low) + RandomNumber(low, gen);
+}
+
+double MeasureMultiplication(size_t digits, const BigInteger::MultiplicationThresholds& thresholds) {
+  std::mt19937 gen(static_cast<uint32_t>(digits));
+  BigInteger a = RandomNumber(digits, gen);
+  BigInteger b = RandomNumber(digits, gen);
+  BigInteger::SetMultiplicationThresholds(thresholds);
+
+  double best = std::numeric_limits<double>::max();
+  for (int round = 0; round < 5; ++round) {
+    size_t iterations = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed{};
+    do {
+      BigInteger c = a * b;
+      ++iterations;
+      elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed.count() < 0.01);
+    best = std::min(best, elapsed.count() / static_cast<double>(iterations));
+  }
+  return best;
+}
+
+// The smallest size from which one top-level step of the faster algorithm beats the slower one.
+size_t FindCrossover(size_t from, size_t to, BigInteger::MultiplicationThresholds slower,
+                     size_t BigInteger::MultiplicationThresholds::*tier, std::ostream& os) {
+  for (size_t digits = from; digits <= to; digits += digits / 8 + 1) {
+    BigInteger::MultiplicationThresholds faster = slower;
+    faster.*tier = digits;
+
+    double slow = MeasureMultiplication(digits, slower);
+    double fast = MeasureMultiplication(digits, faster);
+    os << "  " << digits << " digits: " << slow * 1e6 << " us vs " << fast * 1e6 << " us\n";
+
+    if (fast < slow) {
+      return digits;
+    }
+  }
+  return to;
+}
+
+}  // namespace
+
+int main() {
+  BigInteger::SetMaxDecimalDigits(BigInteger::kUnlimitedDecimalDigits);
+  BigInteger::MultiplicationThresholds defaults = BigInteger::GetMultiplicationThresholds();
+
+  using Thresholds = BigInteger::MultiplicationThresholds;
+
+  std::cout << "schoolbook vs Karatsuba:\n";
+  size_t karatsuba = FindCrossover(8, 512, {kNoThreshold, kNoThreshold, kNoThreshold, kNoThreshold},
+                                   &Thresholds::karatsuba, std::cout);
+
+  std::cout << "Karatsuba vs Toom-3:\n";
+  size_t toom3 = FindCrossover(karatsuba * 2, 2048, {karatsuba, kNoThreshold, kNoThreshold, kNoThreshold},
+                               &Thresholds::toom3, std::cout);
+
+  std::cout << "Toom-3 vs NTT:\n";
+  size_t ntt =
+      FindCrossover(toom3, 65536, {karatsuba, toom3, kNoThreshold, kNoThreshold}, &Thresholds::ntt, std::cout);
+
+  std::cout << "defaults: karatsuba = " << defaults.karatsuba << ", toom3 = " << defaults.toom3
+            << ", ntt = " << defaults.ntt << "\n";
+  std::cout << "measured: karatsuba = " << karatsuba << ", toom3 = " << toom3 << ", ntt = " << ntt << "\n";
+  return 0;
+}
@@ -1,45 +1,240 @@
 #include "big_integer.h"
 
+#include <bitset>
+#include <cstring>
+#include <deque>
+#include <mutex>
+
+#include "big_integer_stats.h"
+
+// BigIntegerView reads serialized digits in place.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "BigInteger binary views need a little-endian target"
+#endif
+
+namespace {
+
+using big_integer_kernels::Digit;
+using big_integer_stats::Operation;
+
+const Digit kPowersOfTen[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+const size_t kChunkChars = 9;
+
+// Numbers of at most this many digits are converted chunk by chunk, in quadratic time.
+const size_t kDecimalBaseCaseDigits = 32;
+const size_t kDecimalBaseCaseChars = kDecimalBaseCaseDigits * kChunkChars;
+
+// 10^(9 * 2^level), squared up on first use. A deque keeps handed-out references valid as the
+// cache grows. The cache lives for the whole process, so it always grows on the global heap,
+// whatever allocator the caller has installed.
+const DigitBuffer& PowerOfTen(size_t level) {
+  static std::mutex mutex;
+  static std::deque<DigitBuffer> powers;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ScopedDigitAllocator heap(nullptr);
+  if (powers.empty()) {
+    powers.emplace_back();
+    powers.back().PushBack(kPowersOfTen[kChunkChars]);
+  }
+
+  while (powers.size() <= level) {
+    const DigitBuffer& last = powers.back();
+    DigitBuffer square;
+    square.Resize(2 * last.Size());
+    big_integer_kernels::Mul(square.Data(), last.Data(), last.Size(), last.Data(), last.Size());
+    square.Resize(big_integer_kernels::Normalized(square.Data(), square.Size()));
+    powers.push_back(std::move(square));
+  }
+
+  return powers[level];
+}
+
+// Level of the largest cached power 10^(9 * 2^level) with fewer than chars decimal digits.
+size_t SplitLevel(size_t chars) {
+  size_t level = 0;
+  while (kChunkChars << (level + 1) < chars) {
+    ++level;
+  }
+  return level;
+}
+
+Digit ParseChunk(const char* s, size_t len) {
+  Digit chunk = 0;
+  for (size_t i = 0; i < len; ++i) {
+    chunk = chunk * 10 + static_cast<Digit>(s[i] - '0');
+  }
+  return chunk;
+}
+
+// The value of the decimal digits s[0, len), normalized. Long inputs are split at a cached power
+// of ten and the halves are joined with one multiplication.
+DigitBuffer ParseDecimal(const char* s, size_t len) {
+  DigitBuffer res;
+
+  if (len <= kDecimalBaseCaseChars) {
+    res.Reserve(len / kChunkChars + 1);
+    res.PushBack(0);
+
+    size_t first_len = len % kChunkChars == 0 ? kChunkChars : len % kChunkChars;
+    for (size_t i = 0, chunk_len = first_len; i < len; i += chunk_len, chunk_len = kChunkChars) {
+      Digit carry = big_integer_kernels::MulDigitInPlace(res.Data(), res.Size(), kPowersOfTen[chunk_len]);
+      Digit chunk = ParseChunk(s + i, chunk_len);
+      carry += big_integer_kernels::AddInPlace(res.Data(), res.Size(), &chunk, 1);
+      if (carry != 0) {
+        res.PushBack(carry);
+      }
+    }
+    return res;
+  }
+
+  size_t level = SplitLevel(len);
+  size_t low_len = kChunkChars << level;
+  const DigitBuffer& power = PowerOfTen(level);
+  DigitBuffer high = ParseDecimal(s, len - low_len);
+  DigitBuffer low = ParseDecimal(s + len - low_len, low_len);
+
+  // high * 10^low_len + low < (high + 1) * 10^low_len, so the sum fits next to the product.
+  res.Resize(high.Size() + power.Size());
+  big_integer_kernels::Mul(res.Data(), high.Data(), high.Size(), power.Data(), power.Size());
+  big_integer_kernels::AddInPlace(res.Data(), res.Size(), low.Data(), low.Size());
+  res.Resize(std::max<size_t>(big_integer_kernels::Normalized(res.Data(), res.Size()), 1));
+
+  return res;
+}
+
+// Writes a[0, n) < 10^width to out[0, width) with leading zeros. Long values are split by a
+// division by a cached power of ten into halves that are written independently.
+void WriteDecimal(const Digit* a, size_t n, char* out, size_t width) {
+  n = big_integer_kernels::Normalized(a, n);
+
+  if (n <= kDecimalBaseCaseDigits || width <= kDecimalBaseCaseChars) {
+    Digit rest[kDecimalBaseCaseDigits];
+    std::copy(a, a + n, rest);
+
+    while (width > 0) {
+      Digit chunk = big_integer_kernels::DivModDigit(rest, rest, n, kPowersOfTen[kChunkChars]);
+      n = big_integer_kernels::Normalized(rest, n);
+      for (size_t i = 0; i < kChunkChars && width > 0; ++i) {
+        out[--width] = static_cast<char>('0' + chunk % 10);
+        chunk /= 10;
+      }
+    }
+    return;
+  }
+
+  size_t level = SplitLevel(width);
+  size_t low_width = kChunkChars << level;
+  const DigitBuffer& power = PowerOfTen(level);
+
+  if (big_integer_kernels::Compare(a, n, power.Data(), power.Size()) < 0) {
+    std::fill(out, out + width - low_width, '0');
+    WriteDecimal(a, n, out + width - low_width, low_width);
+    return;
+  }
+
+  DigitBuffer quotient;
+  DigitBuffer remainder;
+  quotient.Resize(n - power.Size() + 1);
+  remainder.Resize(power.Size());
+  big_integer_kernels::DivMod(quotient.Data(), remainder.Data(), a, n, power.Data(), power.Size());
+
+  WriteDecimal(quotient.Data(), quotient.Size(), out, width - low_width);
+  WriteDecimal(remainder.Data(), remainder.Size(), out + width - low_width, low_width);
+}
+
+// Whether a[0, n) < 10^exponent, with the power assembled from the cached ones in digit scratch.
+bool LessThanPowerOfTen(const Digit* a, size_t n, size_t exponent) {
+  DigitBuffer power;
+  power.PushBack(kPowersOfTen[exponent % kChunkChars]);
+  for (size_t level = 0, chunks = exponent / kChunkChars; chunks != 0; ++level, chunks >>= 1) {
+    if ((chunks & 1) == 0) {
+      continue;
+    }
+    const DigitBuffer& factor = PowerOfTen(level);
+    DigitBuffer product;
+    product.Resize(power.Size() + factor.Size());
+    big_integer_kernels::Mul(product.Data(), power.Data(), power.Size(), factor.Data(), factor.Size());
+    product.Resize(big_integer_kernels::Normalized(product.Data(), product.Size()));
+    power = std::move(product);
+  }
+  return big_integer_kernels::Compare(a, n, power.Data(), power.Size()) < 0;
+}
+
+// a[0, n) = 2^(32n) - a[0, n): the two's complement negation.
+void Negate(Digit* a, size_t n) {
+  Digit carry = 1;
+  for (size_t i = 0; i < n; ++i) {
+    a[i] = ~a[i] + carry;
+    carry &= a[i] == 0;
+  }
+}
+
+}  // namespace
+
+size_t BigInteger::max_decimal_digits_ = kDefaultMaxDecimalDigits;
+size_t BigInteger::max_bits_ = BitsForDecimalDigits(kDefaultMaxDecimalDigits);
+
+size_t BigInteger::GetMaxDecimalDigits() {
+  return max_decimal_digits_;
+}
+
+void BigInteger::SetMaxDecimalDigits(size_t digits) {
+  max_decimal_digits_ = digits;
+  max_bits_ = BitsForDecimalDigits(digits);
+}
+
+BigInteger::MultiplicationThresholds BigInteger::GetMultiplicationThresholds() {
+  return big_integer_kernels::Thresholds();
+}
+
+void BigInteger::SetMultiplicationThresholds(const MultiplicationThresholds& thresholds) {
+  big_integer_kernels::Thresholds() = thresholds;
+}
+
+size_t BigInteger::GetMultiplicationThreads() {
+  return big_integer_kernels::ThreadCount();
+}
+
+void BigInteger::SetMultiplicationThreads(size_t threads) {
+  big_integer_kernels::SetThreadCount(threads);
+}
+
 BigInteger::BigInteger() : is_negative_(false) {
-  digits_.push_back(0);
+  digits_.PushBack(0);
 }
 
 BigInteger::BigInteger(int64_t value) {
   is_negative_ = value < 0;
-  uint64_t abs_val = is_negative_ ? -value : value;
+  uint64_t abs_val = is_negative_ ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
 
   while (abs_val > 0) {
-    digits_.push_back(abs_val % kBase);
-    abs_val /= kBase;
+    digits_.PushBack(static_cast<Digit>(abs_val));
+    abs_val >>= kDigitBits;
   }
 
-  if (digits_.empty()) {
-    digits_.push_back(0);
+  if (digits_.Empty()) {
+    digits_.PushBack(0);
   }
 
   CheckOverflow();
 }
 
-BigInteger::BigInteger(const std::string& s) {
-  if (s.size() - 1 > kMaxDecimalDigits) {
-    throw BigIntegerOverflow{};
-  }
+BigInteger::BigInteger(BigIntegerView view) : is_negative_(view.is_negative_) {
+  digits_.Resize(std::max<size_t>(view.size_, 1));
+  std::copy(view.digits_, view.digits_ + view.size_, digits_.Data());
+  CheckOverflow();
+}
 
-  is_negative_ = !s.empty() && s[0] == '-';
-  size_t pos = is_negative_;
+BigInteger::BigInteger(const std::string& s) : BigInteger() {
+  std::from_chars_result result = FromChars(s.data(), s.data() + s.size(), *this);
 
-  for (size_t i = s.size(); i > pos;) {
-    size_t len = std::min(static_cast<size_t>(kBaseDigits), i - pos);
-    i -= len;
-    digits_.push_back(std::stoi(s.substr(i, len)));
+  if (result.ec == std::errc::result_out_of_range) {
+    throw BigIntegerOverflow{};
   }
-
-  if (digits_.empty()) {
-    digits_.push_back(0);
-    is_negative_ = false;
+  if (result.ec != std::errc{} || result.ptr != s.data() + s.size()) {
+    throw std::invalid_argument("BigInteger: not a decimal number");
   }
-
-  CheckOverflow();
 }
 
 bool BigInteger::IsNegative() const {
@@ -47,21 +242,49 @@ bool BigInteger::IsNegative() const {
 }
 
 BigInteger::operator bool() const {
-  return digits_.size() != 1 || digits_[0] != 0;
+  return digits_.Size() != 1 || digits_[0] != 0;
+}
+
+size_t BigInteger::BitLength() const {
+  size_t bits = (digits_.Size() - 1) * kDigitBits;
+
+  for (Digit top = digits_.Back(); top != 0; top >>= 1) {
+    ++bits;
+  }
+
+  return bits;
+}
+
+size_t BigInteger::PopCount() const {
+  size_t count = 0;
+  for (Digit digit : digits_) {
+    count += std::bitset<kDigitBits>(digit).count();
+  }
+  return count;
 }
 
 void BigInteger::CheckOverflow() const {
-  if (digits_.size() * kBaseDigits > kMaxDecimalDigits) {
+  if (BitLength() > max_bits_) {
     throw BigIntegerOverflow{};
   }
 }
 
+BigInteger BigInteger::FromDigits(DigitBuffer digits, bool is_negative) {
+  BigInteger res;
+  if (!digits.Empty()) {
+    res.digits_ = std::move(digits);
+    res.is_negative_ = is_negative;
+    res.RemoveLeadingZeros();
+  }
+  return res;
+}
+
 void BigInteger::RemoveLeadingZeros() {
-  while (digits_.size() > 1 && digits_.back() == 0) {
-    digits_.pop_back();
+  while (digits_.Size() > 1 && digits_.Back() == 0) {
+    digits_.PopBack();
   }
 
-  if (digits_.size() == 1 && digits_[0] == 0) {
+  if (digits_.Size() == 1 && digits_[0] == 0) {
     is_negative_ = false;
   }
 }
@@ -84,33 +307,43 @@ BigInteger BigInteger::operator-() const {
   return copy;
 }
 
-BigInteger& BigInteger::operator+=(const BigInteger& other) {
-  if (!other) {
-    return *this;
-  }
+void BigInteger::AddMagnitude(const BigInteger& other) {
+  size_t len = std::max(digits_.Size(), other.digits_.Size());
 
-  if (is_negative_ != other.is_negative_) {
-    return *this -= -other;
-  }
+  // Reserve first: once the buffer stops moving, other's digits are stable even when other is *this.
+  digits_.Reserve(len + 1);
+  digits_.Resize(len);
 
-  size_t max_len = std::max(digits_.size(), other.digits_.size());
-  digits_.resize(max_len, 0);
-  Digit carry = 0;
+  Digit carry = big_integer_kernels::AddInPlace(digits_.Data(), len, other.digits_.Data(), other.digits_.Size());
+  if (carry != 0) {
+    digits_.PushBack(carry);
+  }
+}
 
-  for (size_t i = 0; i < max_len || carry; ++i) {
-    if (i == digits_.size()) {
-      digits_.push_back(0);
-    }
+void BigInteger::SubtractMagnitude(const BigInteger& other) {
+  size_t n = digits_.Size();
+  size_t m = other.digits_.Size();
 
-    Digit sum = digits_[i] + carry;
+  if (big_integer_kernels::Compare(digits_.Data(), n, other.digits_.Data(), m) >= 0) {
+    big_integer_kernels::SubInPlace(digits_.Data(), n, other.digits_.Data(), m);
+  } else {
+    // |other| > |*this|, so other is a different object and survives the resize.
+    digits_.Resize(m);
+    big_integer_kernels::SubFromInPlace(digits_.Data(), other.digits_.Data(), m);
+    is_negative_ = !is_negative_;
+  }
 
-    if (i < other.digits_.size()) {
-      sum += other.digits_[i];
-    }
+  RemoveLeadingZeros();
+}
 
-    digits_[i] = sum % kBase;
-    carry = sum / kBase;
+BigInteger& BigInteger::operator+=(const BigInteger& other) {
+  BIG_INTEGER_STATS_OPERATION(Operation::kAdd, std::max(digits_.Size(), other.digits_.Size()));
+  if (is_negative_ == other.is_negative_) {
+    AddMagnitude(other);
+  } else {
+    SubtractMagnitude(other);
   }
+
   CheckOverflow();
 
   return *this;
@@ -123,42 +356,13 @@ BigInteger BigInteger::operator+(const BigInteger& other) const {
 }
 
 BigInteger& BigInteger::operator-=(const BigInteger& other) {
-  if (!other) {
-    return *this;
-  }
-
+  BIG_INTEGER_STATS_OPERATION(Operation::kSub, std::max(digits_.Size(), other.digits_.Size()));
   if (is_negative_ != other.is_negative_) {
-    *this += -other;
-    return *this;
+    AddMagnitude(other);
+  } else {
+    SubtractMagnitude(other);
   }
 
-  if (Abs(*this) < Abs(other)) {
-    BigInteger tmp = other;
-    tmp -= *this;
-    *this = tmp;
-    is_negative_ = !is_negative_;
-    return *this;
-  }
-
-  Digit borrow = 0;
-  for (size_t i = 0; i < digits_.size(); ++i) {
-    int64_t cur = static_cast<int64_t>(digits_[i]) - borrow;
-
-    if (i < other.digits_.size()) {
-      cur -= other.digits_[i];
-    }
-
-    if (cur < 0) {
-      cur += kBase;
-      borrow = 1;
-    } else {
-      borrow = 0;
-    }
-
-    digits_[i] = static_cast<Digit>(cur);
-  }
-
-  RemoveLeadingZeros();
   CheckOverflow();
 
   return *this;
@@ -171,20 +375,25 @@ BigInteger BigInteger::operator-(const BigInteger& other) const {
 }
 
 BigInteger& BigInteger::operator*=(const BigInteger& other) {
-  std::vector<Digit> res(digits_.size() + other.digits_.size(), 0);
-
-  for (size_t i = 0; i < digits_.size(); ++i) {
-    DoubleDigit carry = 0;
-    for (size_t j = 0; j < other.digits_.size() || carry != 0; ++j) {
-      DoubleDigit cur =
-          res[i + j] + static_cast<DoubleDigit>(digits_[i]) * (j < other.digits_.size() ? other.digits_[j] : 0) + carry;
+  BIG_INTEGER_STATS_OPERATION(this == &other ? Operation::kSqr : Operation::kMul,
+                              std::min(digits_.Size(), other.digits_.Size()));
+  if (*this && other && BitLength() + other.BitLength() - 1 > max_bits_) {
+    throw BigIntegerOverflow{};
+  }
 
-      res[i + j] = static_cast<Digit>(cur % kBase);
-      carry = cur / kBase;
+  if (other.digits_.Size() == 1 && this != &other) {
+    Digit carry = big_integer_kernels::MulDigitInPlace(digits_.Data(), digits_.Size(), other.digits_[0]);
+    if (carry != 0) {
+      digits_.PushBack(carry);
     }
+  } else {
+    DigitBuffer res;
+    res.Resize(digits_.Size() + other.digits_.Size());
+    big_integer_kernels::Mul(res.Data(), digits_.Data(), digits_.Size(), other.digits_.Data(),
+                             other.digits_.Size());
+    digits_ = std::move(res);
   }
 
-  digits_ = std::move(res);
   is_negative_ = (is_negative_ != other.is_negative_);
 
   RemoveLeadingZeros();
@@ -195,80 +404,189 @@ BigInteger& BigInteger::operator*=(const BigInteger& other) {
 
 BigInteger BigInteger::operator*(const BigInteger& other) const {
   BigInteger result = *this;
-  result *= other;
+  // x * x multiplies the copy by itself, so that the squaring kernels see a square.
+  result *= this == &other ? result : other;
   return result;
 }
 
-BigInteger BigInteger::operator/(const BigInteger& other) const {
-  if (other == 0) {
+std::pair<BigInteger, BigInteger> DivMod(const BigInteger& a, const BigInteger& b) {
+  if (!b) {
     throw BigIntegerDivisionByZero{};
   }
+  BIG_INTEGER_STATS_OPERATION(Operation::kDivMod, b.digits_.Size());
 
-  BigInteger abs_dividend = Abs(*this);
-  BigInteger abs_divisor = Abs(other);
-  BigInteger result;
+  if (big_integer_kernels::Compare(a.digits_.Data(), a.digits_.Size(), b.digits_.Data(), b.digits_.Size()) < 0) {
+    return {BigInteger(), a};
+  }
 
-  int32_t result_len =
-      static_cast<int32_t>(abs_dividend.digits_.size()) - static_cast<int32_t>(abs_divisor.digits_.size()) + 1;
+  size_t n = a.digits_.Size();
+  size_t m = b.digits_.Size();
+  BigInteger quotient;
+  BigInteger remainder;
+  quotient.digits_.Resize(n - m + 1);
+  remainder.digits_.Resize(m);
 
-  if (result_len <= 0) {
-    return {0};
-  }
+  big_integer_kernels::DivMod(quotient.digits_.Data(), remainder.digits_.Data(), a.digits_.Data(), n,
+                              b.digits_.Data(), m);
 
-  result.digits_.resize(result_len, 0);
+  quotient.is_negative_ = a.is_negative_ != b.is_negative_;
+  remainder.is_negative_ = a.is_negative_;
+  quotient.RemoveLeadingZeros();
+  remainder.RemoveLeadingZeros();
 
-  BigInteger current;
-  for (int i = static_cast<int>(abs_dividend.digits_.size() - 1); i >= static_cast<int>(result_len - 1); --i) {
-    current = current * kBase + abs_dividend.digits_[i];
-  }
+  return {std::move(quotient), std::move(remainder)};
+}
 
-  for (size_t i = 0; i < static_cast<size_t>(result_len); ++i) {
-    Digit left = 0;
-    Digit right = kBase + 1;
-    while (right - left > 1) {
-      Digit mid = (left + right) / 2;
+BigInteger BigInteger::operator/(const BigInteger& other) const {
+  return DivMod(*this, other).first;
+}
 
-      if (abs_divisor * mid <= current) {
-        left = mid;
-      } else {
-        right = mid;
-      }
-    }
+BigInteger& BigInteger::operator/=(const BigInteger& other) {
+  *this = DivMod(*this, other).first;
+  return *this;
+}
 
-    result.digits_[result_len - i - 1] = left;
-    current -= abs_divisor * left;
+BigInteger BigInteger::operator%(const BigInteger& other) const {
+  return DivMod(*this, other).second;
+}
 
-    if (i + 1 != static_cast<size_t>(result_len)) {
-      current = current * kBase + abs_dividend.digits_[result_len - i - 2];
-    }
+BigInteger& BigInteger::operator%=(const BigInteger& other) {
+  *this = DivMod(*this, other).second;
+  return *this;
+}
+
+template <class Op>
+BigInteger BigInteger::Bitwise(const BigInteger& a, const BigInteger& b, Op op) {
+  BIG_INTEGER_STATS_OPERATION(Operation::kBitwise, std::max(a.digits_.Size(), b.digits_.Size()));
+  // One digit more than either operand leaves room for the sign bit.
+  size_t n = std::max(a.digits_.Size(), b.digits_.Size()) + 1;
+
+  DigitBuffer res;
+  DigitBuffer other;
+  res.Resize(n);
+  other.Resize(n);
+  std::copy(a.digits_.begin(), a.digits_.end(), res.Data());
+  std::copy(b.digits_.begin(), b.digits_.end(), other.Data());
+  if (a.is_negative_) {
+    Negate(res.Data(), n);
+  }
+  if (b.is_negative_) {
+    Negate(other.Data(), n);
   }
 
-  result.is_negative_ = (is_negative_ != other.is_negative_);
-  result.RemoveLeadingZeros();
+  for (size_t i = 0; i < n; ++i) {
+    res[i] = op(res[i], other[i]);
+  }
 
-  if (result.digits_.empty()) {
-    result.digits_.push_back(0);
+  bool is_negative = (res[n - 1] >> (kDigitBits - 1)) != 0;
+  if (is_negative) {
+    Negate(res.Data(), n);
   }
 
+  // -2^k ^ 2^k is -2^(k + 1): the result can be a bit longer than both operands.
+  BigInteger result = FromDigits(std::move(res), is_negative);
   result.CheckOverflow();
-
   return result;
 }
 
-BigInteger& BigInteger::operator/=(const BigInteger& other) {
-  *this = *this / other;
+BigInteger BigInteger::operator~() const {
+  BigInteger res = -*this;
+  --res;
+  return res;
+}
+
+BigInteger& BigInteger::operator&=(const BigInteger& other) {
+  return *this = *this & other;
+}
+
+BigInteger BigInteger::operator&(const BigInteger& other) const {
+  return Bitwise(*this, other, [](Digit x, Digit y) {
+    return x & y;
+  });
+}
+
+BigInteger& BigInteger::operator|=(const BigInteger& other) {
+  return *this = *this | other;
+}
+
+BigInteger BigInteger::operator|(const BigInteger& other) const {
+  return Bitwise(*this, other, [](Digit x, Digit y) {
+    return x | y;
+  });
+}
+
+BigInteger& BigInteger::operator^=(const BigInteger& other) {
+  return *this = *this ^ other;
+}
+
+BigInteger BigInteger::operator^(const BigInteger& other) const {
+  return Bitwise(*this, other, [](Digit x, Digit y) {
+    return x ^ y;
+  });
+}
+
+BigInteger& BigInteger::operator<<=(size_t shift) {
+  BIG_INTEGER_STATS_OPERATION(Operation::kShift, digits_.Size());
+  if (!*this) {
+    return *this;
+  }
+  if (shift > max_bits_ || BitLength() + shift > max_bits_) {
+    throw BigIntegerOverflow{};
+  }
+
+  size_t digit_shift = shift / kDigitBits;
+  size_t n = digits_.Size();
+  digits_.Resize(n + digit_shift + 1);
+
+  Digit* data = digits_.Data();
+  std::copy_backward(data, data + n, data + n + digit_shift);
+  std::fill(data, data + digit_shift, 0);
+  data[n + digit_shift] = big_integer_kernels::ShiftLeft(data + digit_shift, data + digit_shift, n,
+                                                         static_cast<int>(shift % kDigitBits));
+
+  RemoveLeadingZeros();
   return *this;
 }
 
-BigInteger BigInteger::operator%(const BigInteger& other) const {
-  return *this - *this / other * other;
+BigInteger BigInteger::operator<<(size_t shift) const {
+  BigInteger res = *this;
+  res <<= shift;
+  return res;
 }
 
-BigInteger& BigInteger::operator%=(const BigInteger& other) {
-  *this = *this % other;
+BigInteger& BigInteger::operator>>=(size_t shift) {
+  BIG_INTEGER_STATS_OPERATION(Operation::kShift, digits_.Size());
+  bool is_negative = is_negative_;
+  size_t digit_shift = shift / kDigitBits;
+  size_t n = digits_.Size();
+
+  if (digit_shift >= n) {
+    return *this = is_negative ? BigInteger(-1) : BigInteger();
+  }
+
+  Digit* data = digits_.Data();
+  bool inexact = std::any_of(data, data + digit_shift, [](Digit digit) {
+    return digit != 0;
+  });
+  std::copy(data + digit_shift, data + n, data);
+  digits_.Resize(n - digit_shift);
+  inexact |= big_integer_kernels::ShiftRight(data, data, n - digit_shift, static_cast<int>(shift % kDigitBits)) != 0;
+
+  RemoveLeadingZeros();
+
+  // Rounding toward negative infinity takes a negative value one further once bits are lost.
+  if (is_negative && inexact) {
+    --*this;
+  }
   return *this;
 }
 
+BigInteger BigInteger::operator>>(size_t shift) const {
+  BigInteger res = *this;
+  res >>= shift;
+  return res;
+}
+
 BigInteger& BigInteger::operator++() {
   *this += BigInteger(1);
   return *this;
@@ -304,17 +622,8 @@ bool operator<(const BigInteger& a, const BigInteger& b) {
     return a.is_negative_;
   }
 
-  if (a.digits_.size() != b.digits_.size()) {
-    return a.is_negative_ ? a.digits_.size() > b.digits_.size() : a.digits_.size() < b.digits_.size();
-  }
-
-  for (size_t i = a.digits_.size(); i-- > 0;) {
-    if (a.digits_[i] != b.digits_[i]) {
-      return a.is_negative_ ? a.digits_[i] > b.digits_[i] : a.digits_[i] < b.digits_[i];
-    }
-  }
-
-  return false;
+  int cmp = big_integer_kernels::Compare(a.digits_.Data(), a.digits_.Size(), b.digits_.Data(), b.digits_.Size());
+  return a.is_negative_ ? cmp > 0 : cmp < 0;
 }
 
 bool operator<=(const BigInteger& a, const BigInteger& b) {
@@ -329,21 +638,49 @@ bool operator>=(const BigInteger& a, const BigInteger& b) {
   return !(a < b);
 }
 
-std::ostream& operator<<(std::ostream& os, const BigInteger& num) {
-  if (num.IsNegative()) {
-    os << '-';
+std::to_chars_result ToChars(char* first, char* last, const BigInteger& value) {
+  return ToChars(first, last, BigIntegerView(value));
+}
+
+std::from_chars_result FromChars(const char* first, const char* last, BigInteger& value) {
+  const char* begin = first;
+  bool negative = begin != last && *begin == '-';
+  begin += negative;
+
+  const char* end = begin;
+  while (end != last && *end >= '0' && *end <= '9') {
+    ++end;
   }
 
-  auto it = num.digits_.rbegin();
-  os << *it++;
+  if (begin == end) {
+    return {first, std::errc::invalid_argument};
+  }
+
+  while (begin + 1 != end && *begin == '0') {
+    ++begin;
+  }
+
+  BIG_INTEGER_STATS_OPERATION(Operation::kParse, static_cast<size_t>(end - begin) / kChunkChars + 1);
 
-  while (it != num.digits_.rend()) {
-    os.width(BigInteger::kBaseDigits);
-    os.fill('0');
-    os << *it++;
+  if (static_cast<size_t>(end - begin) > BigInteger::max_decimal_digits_) {
+    return {end, std::errc::result_out_of_range};
   }
 
-  return os;
+  BigInteger res;
+  res.digits_ = ParseDecimal(begin, static_cast<size_t>(end - begin));
+  res.is_negative_ = negative;
+  res.RemoveLeadingZeros();
+
+  if (res.BitLength() > BigInteger::max_bits_) {
+    return {end, std::errc::result_out_of_range};
+  }
+
+  value = std::move(res);
+  return {end, std::errc{}};
+}
+
+std::ostream& operator<<(std::ostream& os, const BigInteger& num) {
+  return os << BigIntegerView(num);
 }
 
 std::istream& operator>>(std::istream& is, BigInteger& num) {
@@ -353,4 +690,169 @@ std::istream& operator>>(std::istream& is, BigInteger& num) {
   num = BigInteger(s);
 
   return is;
-}
\ No newline at end of file
+}
+
+BigIntegerView::BigIntegerView(const Digit* digits, size_t size, bool is_negative)
+    : digits_(digits), size_(size), is_negative_(is_negative) {
+}
+
+BigIntegerView::BigIntegerView(const BigInteger& value)
+    : BigIntegerView(value.digits_.Data(), value ? value.digits_.Size() : 0, value.is_negative_) {
+}
+
+BigIntegerView BigIntegerView::FromBinary(const void* data, size_t size) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+  if (reinterpret_cast<uintptr_t>(bytes) % alignof(Digit) != 0) {
+    throw std::invalid_argument("BigIntegerView: misaligned data");
+  }
+  if (size < kHeaderBytes) {
+    throw std::invalid_argument("BigIntegerView: truncated data");
+  }
+
+  uint64_t header = 0;
+  for (size_t i = 0; i < kHeaderBytes; ++i) {
+    header |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+
+  uint64_t count = header >> 1;
+  bool is_negative = (header & 1) != 0;
+  if (count > (size - kHeaderBytes) / sizeof(Digit)) {
+    throw std::invalid_argument("BigIntegerView: truncated data");
+  }
+
+  const Digit* digits = reinterpret_cast<const Digit*>(bytes + kHeaderBytes);
+  if (count == 0 ? is_negative : digits[count - 1] == 0) {
+    throw std::invalid_argument("BigIntegerView: malformed data");
+  }
+
+  return BigIntegerView(digits, static_cast<size_t>(count), is_negative);
+}
+
+size_t BigIntegerView::BitLength() const {
+  if (size_ == 0) {
+    return 0;
+  }
+
+  size_t bits = (size_ - 1) * big_integer_kernels::kDigitBits;
+  for (Digit top = digits_[size_ - 1]; top != 0; top >>= 1) {
+    ++bits;
+  }
+  return bits;
+}
+
+size_t BigIntegerView::DecimalWidth() const {
+  // log10(2) < 0.30103, so this never undercounts and overcounts by at most one.
+  return BitLength() * 30103 / 100000 + 1;
+}
+
+bool BigIntegerView::IsNegative() const {
+  return is_negative_;
+}
+
+BigIntegerView::operator bool() const {
+  return size_ != 0;
+}
+
+bool operator==(BigIntegerView a, BigIntegerView b) {
+  return a.is_negative_ == b.is_negative_ && a.size_ == b.size_ && std::equal(a.digits_, a.digits_ + a.size_, b.digits_);
+}
+
+bool operator!=(BigIntegerView a, BigIntegerView b) {
+  return !(a == b);
+}
+
+bool operator<(BigIntegerView a, BigIntegerView b) {
+  if (a.is_negative_ != b.is_negative_) {
+    return a.is_negative_;
+  }
+
+  int cmp = big_integer_kernels::Compare(a.digits_, a.size_, b.digits_, b.size_);
+  return a.is_negative_ ? cmp > 0 : cmp < 0;
+}
+
+bool operator<=(BigIntegerView a, BigIntegerView b) {
+  return !(b < a);
+}
+
+bool operator>(BigIntegerView a, BigIntegerView b) {
+  return b < a;
+}
+
+bool operator>=(BigIntegerView a, BigIntegerView b) {
+  return !(a < b);
+}
+
+BigInteger operator*(BigIntegerView a, BigIntegerView b) {
+  if (!a || !b) {
+    return BigInteger();
+  }
+  if (a.BitLength() + b.BitLength() - 1 > BigInteger::max_bits_) {
+    throw BigIntegerOverflow{};
+  }
+
+  DigitBuffer res;
+  res.Resize(a.size_ + b.size_);
+  big_integer_kernels::Mul(res.Data(), a.digits_, a.size_, b.digits_, b.size_);
+
+  BigInteger product = BigInteger::FromDigits(std::move(res), a.is_negative_ != b.is_negative_);
+  product.CheckOverflow();
+  return product;
+}
+
+size_t BinarySize(BigIntegerView value) {
+  return BigIntegerView::kHeaderBytes + value.size_ * sizeof(BigIntegerView::Digit);
+}
+
+unsigned char* WriteBinary(BigIntegerView value, unsigned char* out) {
+  uint64_t header = static_cast<uint64_t>(value.size_) << 1 | static_cast<uint64_t>(value.is_negative_);
+  for (size_t i = 0; i < BigIntegerView::kHeaderBytes; ++i) {
+    *out++ = static_cast<unsigned char>(header >> (8 * i));
+  }
+
+  for (size_t i = 0; i < value.size_; ++i) {
+    for (size_t j = 0; j < sizeof(BigIntegerView::Digit); ++j) {
+      *out++ = static_cast<unsigned char>(value.digits_[i] >> (8 * j));
+    }
+  }
+
+  return out;
+}
+
+std::to_chars_result ToChars(char* first, char* last, BigIntegerView value) {
+  size_t width = value.DecimalWidth();
+  size_t available = static_cast<size_t>(last - first);
+
+  if (available < value.is_negative_ + width) {
+    // The estimate may be one too high, and then the text is exactly one character shorter.
+    if (available + 1 < value.is_negative_ + width || width == 1 ||
+        !LessThanPowerOfTen(value.digits_, value.size_, width - 1)) {
+      return {last, std::errc::value_too_large};
+    }
+    --width;
+  }
+
+  BIG_INTEGER_STATS_OPERATION(Operation::kPrint, value.size_);
+
+  if (value.is_negative_) {
+    *first++ = '-';
+  }
+
+  WriteDecimal(value.digits_, value.size_, first, width);
+
+  size_t zeros = 0;
+  while (zeros + 1 < width && first[zeros] == '0') {
+    ++zeros;
+  }
+  std::memmove(first, first + zeros, width - zeros);
+
+  return {first + width - zeros, std::errc{}};
+}
+
+std::ostream& operator<<(std::ostream& os, BigIntegerView value) {
+  std::string text(value.is_negative_ + value.DecimalWidth(), '\0');
+  std::to_chars_result result = ToChars(text.data(), text.data() + text.size(), value);
+  text.resize(static_cast<size_t>(result.ptr - text.data()));
+
+  return os << text;
+}
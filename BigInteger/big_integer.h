@@ -8,9 +8,26 @@
 #include <stdexcept>
 #include <cstdint>
 #include <algorithm>
+#include <limits>
+#include <utility>
+#include <charconv>
+#include <system_error>
 
 #include <type_traits>
 
+#include "big_integer_kernels.h"
+#include "digit_buffer.h"
+
+namespace big_integer_expr {
+class Accumulator;
+}  // namespace big_integer_expr
+
+class BigIntegerView;
+template <size_t Bits>
+class FixedInteger;
+class MontgomeryContext;
+struct ExtendedGcdResult;
+
 class BigIntegerOverflow : public std::runtime_error {
  public:
   BigIntegerOverflow() : std::runtime_error("BigIntegerOverflow") {
@@ -25,20 +42,66 @@ class BigIntegerDivisionByZero : public std::runtime_error {
 
 class BigInteger {
  private:
-  using Digit = uint32_t;
-  using DoubleDigit = uint64_t;
-  static const Digit kBase = 10000;
-  static const int kBaseDigits = 4;
-  static const size_t kMaxDecimalDigits = 30000;
+  using Digit = big_integer_kernels::Digit;
+  using DoubleDigit = big_integer_kernels::DoubleDigit;
+  static const int kDigitBits = big_integer_kernels::kDigitBits;
+
+  static size_t max_decimal_digits_;
+  static size_t max_bits_;
+
+  // ceil(digits * log2(10)): the bit length of 10^digits. Saturates for limits no value can reach.
+  static constexpr size_t BitsForDecimalDigits(size_t digits) {
+    return digits > std::numeric_limits<size_t>::max() / 33219281 ? std::numeric_limits<size_t>::max()
+                                                                  : digits * 33219281 / 10000000 + 1;
+  }
 
-  std::vector<Digit> digits_;
+  DigitBuffer digits_;
   bool is_negative_;
 
   void RemoveLeadingZeros();
+  // |*this| += |other| and |*this| -= |other| in place; other may be *this.
+  void AddMagnitude(const BigInteger& other);
+  void SubtractMagnitude(const BigInteger& other);
   void CheckOverflow() const;
+  // Little-endian magnitude, possibly with leading zeros, and a sign; no overflow check.
+  static BigInteger FromDigits(DigitBuffer digits, bool is_negative);
+  // Applies op digit by digit to the two's complements of a and b.
+  template <class Op>
+  static BigInteger Bitwise(const BigInteger& a, const BigInteger& b, Op op);
   friend BigInteger Abs(const BigInteger& a);
+  friend class big_integer_expr::Accumulator;
+  friend class BigIntegerView;
+  friend BigInteger operator*(BigIntegerView a, BigIntegerView b);
+  friend class MontgomeryContext;
+  template <size_t Bits>
+  friend class FixedInteger;
+  friend BigInteger PowMod(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus);
+  friend BigInteger Gcd(const BigInteger& a, const BigInteger& b);
+  friend ExtendedGcdResult ExtendedGcd(const BigInteger& a, const BigInteger& b);
 
  public:
+  using MultiplicationThresholds = big_integer_kernels::MultiplicationThresholds;
+
+  static const size_t kDefaultMaxDecimalDigits = 30000;
+  static const size_t kUnlimitedDecimalDigits = std::numeric_limits<size_t>::max();
+
+  // Values longer than this many decimal digits make operations throw BigIntegerOverflow.
+  // Not synchronised: set it before any BigInteger work starts.
+  static size_t GetMaxDecimalDigits();
+  static void SetMaxDecimalDigits(size_t digits);
+
+  // Operand sizes, in 32-bit digits of the shorter factor, from which operator*= switches
+  // from schoolbook to Karatsuba, from Karatsuba to Toom-3 and from Toom-3 to NTT, and from
+  // which it goes parallel.
+  static MultiplicationThresholds GetMultiplicationThresholds();
+  static void SetMultiplicationThresholds(const MultiplicationThresholds& thresholds);
+
+  // Threads, counting the caller, that products with at least thresholds.parallel digits in
+  // the shorter factor spread over. Defaults to 1; results do not depend on it. Not
+  // synchronised: set it while no multiplication is running.
+  static size_t GetMultiplicationThreads();
+  static void SetMultiplicationThreads(size_t threads);
+
   BigInteger();
   BigInteger(int64_t value);  // NOLINT
   explicit BigInteger(const std::string& str);
@@ -47,6 +110,9 @@ class BigInteger {
   explicit BigInteger(T c_str) : BigInteger(std::string(c_str)) {
   }
 
+  // Copies the value out of a view, e.g. one over serialized data.
+  explicit BigInteger(BigIntegerView view);
+
   BigInteger operator+() const;
   BigInteger operator-() const;
 
@@ -65,6 +131,28 @@ class BigInteger {
   BigInteger operator%(const BigInteger& other) const;
   BigInteger& operator%=(const BigInteger& other);
 
+  // Bitwise operations in two's complement, as if both operands were sign-extended without
+  // end: ~x is -x - 1 and >> rounds toward negative infinity. Shifts take linear time.
+  BigInteger operator~() const;
+
+  BigInteger& operator&=(const BigInteger& other);
+  BigInteger operator&(const BigInteger& other) const;
+
+  BigInteger& operator|=(const BigInteger& other);
+  BigInteger operator|(const BigInteger& other) const;
+
+  BigInteger& operator^=(const BigInteger& other);
+  BigInteger operator^(const BigInteger& other) const;
+
+  BigInteger& operator<<=(size_t shift);
+  BigInteger operator<<(size_t shift) const;
+
+  BigInteger& operator>>=(size_t shift);
+  BigInteger operator>>(size_t shift) const;
+
+  // Quotient truncated toward zero and the remainder with the sign of a, from a single division.
+  friend std::pair<BigInteger, BigInteger> DivMod(const BigInteger& a, const BigInteger& b);
+
   BigInteger& operator++();
   BigInteger operator++(int);
   BigInteger& operator--();
@@ -73,6 +161,10 @@ class BigInteger {
   bool IsNegative() const;
   explicit operator bool() const;
 
+  // Length of |*this| in bits, 0 for zero, and the number of set bits in |*this|.
+  size_t BitLength() const;
+  size_t PopCount() const;
+
   friend bool operator==(const BigInteger& a, const BigInteger& b);
   friend bool operator!=(const BigInteger& a, const BigInteger& b);
   friend bool operator<(const BigInteger& a, const BigInteger& b);
@@ -80,6 +172,73 @@ class BigInteger {
   friend bool operator>(const BigInteger& a, const BigInteger& b);
   friend bool operator>=(const BigInteger& a, const BigInteger& b);
 
+  // Decimal text without iostreams, in the manner of std::to_chars and std::from_chars. ToChars
+  // reports std::errc::value_too_large when [first, last) is too short; FromChars reads an
+  // optional '-' and decimal digits, reports std::errc::result_out_of_range past the size cap,
+  // and leaves value untouched on error.
+  friend std::to_chars_result ToChars(char* first, char* last, const BigInteger& value);
+  friend std::from_chars_result FromChars(const char* first, const char* last, BigInteger& value);
+
   friend std::ostream& operator<<(std::ostream& os, const BigInteger& num);
   friend std::istream& operator>>(std::istream& is, BigInteger& num);
-};
\ No newline at end of file
+};
+
+// Read-only view of a BigInteger or of one value in the binary form written by WriteBinary,
+// used in place without copying digits, e.g. over a memory-mapped file. The viewed memory must
+// outlive the view. BigInteger converts to it implicitly, so views and values mix freely in
+// comparisons, products and output.
+//
+// Binary form: a 64-bit little-endian header holding the digit count shifted left by one with
+// the sign in bit 0, then that many 32-bit little-endian digits, least significant first,
+// without leading zero digits. Zero has no digits and no sign. With the header, every encoded
+// value is a multiple of 4 bytes long, so values packed back to back in a 4-aligned buffer can
+// all be viewed in place.
+class BigIntegerView {
+ private:
+  using Digit = big_integer_kernels::Digit;
+
+  const Digit* digits_;
+  size_t size_;
+  bool is_negative_;
+
+  BigIntegerView(const Digit* digits, size_t size, bool is_negative);
+  // Decimal digits of the magnitude, possibly one too many.
+  size_t DecimalWidth() const;
+
+ public:
+  static const size_t kHeaderBytes = 8;
+
+  BigIntegerView(const BigInteger& value);  // NOLINT
+
+  // Views the value encoded at the start of [data, data + size), which must be 4-byte aligned
+  // and may continue past it; BinarySize tells where the next value starts. Throws
+  // std::invalid_argument when the bytes are not a well-formed encoding. Values over the size
+  // cap are viewable; it is enforced when they are copied out or multiplied.
+  static BigIntegerView FromBinary(const void* data, size_t size);
+
+  bool IsNegative() const;
+  explicit operator bool() const;
+  size_t BitLength() const;
+
+  friend bool operator==(BigIntegerView a, BigIntegerView b);
+  friend bool operator!=(BigIntegerView a, BigIntegerView b);
+  friend bool operator<(BigIntegerView a, BigIntegerView b);
+  friend bool operator<=(BigIntegerView a, BigIntegerView b);
+  friend bool operator>(BigIntegerView a, BigIntegerView b);
+  friend bool operator>=(BigIntegerView a, BigIntegerView b);
+
+  friend BigInteger operator*(BigIntegerView a, BigIntegerView b);
+
+  // Bytes of the binary form of value, and writing it to out[0, BinarySize(value)); returns the
+  // end of what was written.
+  friend size_t BinarySize(BigIntegerView value);
+  friend unsigned char* WriteBinary(BigIntegerView value, unsigned char* out);
+
+  friend std::to_chars_result ToChars(char* first, char* last, BigIntegerView value);
+  friend std::ostream& operator<<(std::ostream& os, BigIntegerView value);
+
+  friend class BigInteger;
+};
+
+size_t BinarySize(BigIntegerView value);
+unsigned char* WriteBinary(BigIntegerView value, unsigned char* out);
@@ -0,0 +1,189 @@
+#include "big_integer_batch.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+#include "big_integer_expr.h"
+
+namespace {
+
+using big_integer_expr::Accumulator;
+using big_integer_kernels::DoubleDigit;
+using big_integer_kernels::kDigitBits;
+
+// Two's-complement digits for a sum of count terms of at most digits digits each.
+size_t SumDigits(size_t digits, size_t count) {
+  size_t res = digits + 1;
+  for (DoubleDigit c = count; c > 1; c = (c - 1) / (DoubleDigit{1} << kDigitBits) + 1) {
+    ++res;
+  }
+  return res;
+}
+
+// How many pieces count elements holding digits digits in all are split into for the threads.
+size_t Chunks(size_t count, size_t digits) {
+  if (digits < big_integer_kernels::Thresholds().parallel) {
+    return 1;
+  }
+  return std::max<size_t>(std::min(count, big_integer_kernels::ThreadCount()), 1);
+}
+
+size_t TotalDigits(const std::vector<BigInteger>& values) {
+  size_t total = 0;
+  for (const BigInteger& value : values) {
+    total += Accumulator::Size(value);
+  }
+  return total;
+}
+
+// Calls body(begin, end, chunk) for chunks consecutive ranges covering [0, count), in parallel.
+// An exception thrown by any call is rethrown here once all have finished.
+template <class Body>
+void ForChunks(size_t count, size_t chunks, const Body& body) {
+  std::vector<std::exception_ptr> errors(chunks);
+
+  big_integer_kernels::ParallelFor(chunks, [&](size_t c) {
+    try {
+      body(count * c / chunks, count * (c + 1) / chunks, c);
+    } catch (...) {
+      errors[c] = std::current_exception();
+    }
+  });
+
+  for (const std::exception_ptr& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+// Sum of add_term(acc, i) over i in [0, count), each chunk into its own accumulator.
+template <class AddTerm>
+BigInteger Accumulate(size_t count, size_t digits, size_t chunks, const AddTerm& add_term) {
+  std::vector<Accumulator> partial;
+  partial.reserve(chunks);
+  for (size_t c = 0; c < chunks; ++c) {
+    partial.emplace_back(digits, nullptr);
+  }
+
+  ForChunks(count, chunks, [&](size_t begin, size_t end, size_t c) {
+    for (size_t i = begin; i < end; ++i) {
+      add_term(partial[c], i);
+    }
+  });
+
+  for (size_t c = 1; c < chunks; ++c) {
+    partial[0].Merge(partial[c]);
+  }
+  return partial[0].Finish();
+}
+
+std::vector<BigInteger> MultiplyPairs(const std::vector<BigInteger>& level) {
+  std::vector<BigInteger> next((level.size() + 1) / 2);
+  size_t pairs = level.size() / 2;
+
+  ForChunks(pairs, Chunks(pairs, TotalDigits(level)), [&](size_t begin, size_t end, size_t) {
+    for (size_t i = begin; i < end; ++i) {
+      next[i] = level[2 * i] * level[2 * i + 1];
+    }
+  });
+
+  if (level.size() % 2 != 0) {
+    next.back() = level.back();
+  }
+  return next;
+}
+
+}  // namespace
+
+BigInteger Sum(const std::vector<BigInteger>& values) {
+  size_t digits = 0;
+  for (const BigInteger& value : values) {
+    digits = std::max(digits, Accumulator::Size(value));
+  }
+
+  return Accumulate(values.size(), SumDigits(digits, values.size()), Chunks(values.size(), TotalDigits(values)),
+                    [&](Accumulator& acc, size_t i) {
+                      acc.Add(values[i], false);
+                    });
+}
+
+BigInteger Dot(const std::vector<BigInteger>& a, const std::vector<BigInteger>& b) {
+  if (a.size() != b.size()) {
+    throw std::invalid_argument("Dot: vectors differ in length");
+  }
+
+  size_t digits = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    digits = std::max(digits, Accumulator::Size(a[i]) + Accumulator::Size(b[i]));
+  }
+
+  return Accumulate(a.size(), SumDigits(digits, a.size()), Chunks(a.size(), TotalDigits(a) + TotalDigits(b)),
+                    [&](Accumulator& acc, size_t i) {
+                      acc.AddProduct(a[i], b[i], false);
+                    });
+}
+
+BigInteger Product(const std::vector<BigInteger>& values) {
+  // With a zero factor out of the way no partial product exceeds the result, so the size cap
+  // cannot trip on an intermediate value.
+  bool has_zero = std::any_of(values.begin(), values.end(), [](const BigInteger& value) {
+    return !value;
+  });
+  if (values.empty() || has_zero) {
+    return BigInteger(values.empty() ? 1 : 0);
+  }
+  if (values.size() == 1) {
+    return values[0];
+  }
+
+  std::vector<BigInteger> level = MultiplyPairs(values);
+  while (level.size() > 1) {
+    level = MultiplyPairs(level);
+  }
+  return level[0];
+}
+
+std::vector<BigInteger> Scale(const std::vector<BigInteger>& values, const BigInteger& factor) {
+  std::vector<BigInteger> res(values.size());
+
+  size_t chunks = Chunks(values.size(), TotalDigits(values) * Accumulator::Size(factor));
+  ForChunks(values.size(), chunks, [&](size_t begin, size_t end, size_t) {
+    for (size_t i = begin; i < end; ++i) {
+      res[i] = values[i] * factor;
+    }
+  });
+
+  return res;
+}
+
+std::vector<BigInteger> PrefixSums(const std::vector<BigInteger>& values) {
+  std::vector<BigInteger> res(values.size());
+  size_t chunks = Chunks(values.size(), TotalDigits(values));
+
+  // Totals of every chunk but the last, then the sum of all chunks before each one.
+  std::vector<BigInteger> offsets(chunks);
+  if (chunks > 1) {
+    ForChunks(values.size(), chunks, [&](size_t begin, size_t end, size_t c) {
+      if (c + 1 < chunks) {
+        for (size_t i = begin; i < end; ++i) {
+          offsets[c + 1] += values[i];
+        }
+      }
+    });
+    for (size_t c = 2; c < chunks; ++c) {
+      offsets[c] += offsets[c - 1];
+    }
+  }
+
+  ForChunks(values.size(), chunks, [&](size_t begin, size_t end, size_t c) {
+    BigInteger running = offsets[c];
+    for (size_t i = begin; i < end; ++i) {
+      running += values[i];
+      res[i] = running;
+    }
+  });
+
+  return res;
+}
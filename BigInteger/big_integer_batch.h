@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+
+#include "big_integer.h"
+
+// Whole-column arithmetic over std::vector<BigInteger>. Sums and dot products accumulate every
+// term into one two's-complement buffer sized up front, so there is no reallocation and only the
+// final result is normalised and checked against the size cap. Products multiply up a balanced
+// tree. Long inputs are split across BigInteger::GetMultiplicationThreads() threads; the
+// results do not depend on the thread count.
+//
+// Dot throws std::invalid_argument when a and b differ in length.
+BigInteger Sum(const std::vector<BigInteger>& values);
+BigInteger Dot(const std::vector<BigInteger>& a, const std::vector<BigInteger>& b);
+BigInteger Product(const std::vector<BigInteger>& values);
+
+// values[i] * factor, and the running sums values[0] + ... + values[i].
+std::vector<BigInteger> Scale(const std::vector<BigInteger>& values, const BigInteger& factor);
+std::vector<BigInteger> PrefixSums(const std::vector<BigInteger>& values);
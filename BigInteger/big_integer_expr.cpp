@@ -0,0 +1,95 @@
+#include "big_integer_expr.h"
+
+namespace big_integer_expr {
+
+using big_integer_kernels::Digit;
+
+Accumulator::Accumulator(size_t digits, BigInteger* reuse) {
+  if (reuse != nullptr) {
+    // reuse is about to be overwritten; keep it a valid zero in case evaluation throws.
+    buffer_ = std::move(reuse->digits_);
+    reuse->digits_.PushBack(0);
+    reuse->is_negative_ = false;
+  }
+
+  buffer_.Clear();
+  buffer_.Resize(digits);
+}
+
+size_t Accumulator::Size(const BigInteger& x) {
+  return x.digits_.Size();
+}
+
+void Accumulator::Add(const BigInteger& x, bool negative) {
+  if (negative != x.is_negative_) {
+    big_integer_kernels::SubInPlace(buffer_.Data(), buffer_.Size(), x.digits_.Data(), x.digits_.Size());
+  } else {
+    big_integer_kernels::AddInPlace(buffer_.Data(), buffer_.Size(), x.digits_.Data(), x.digits_.Size());
+  }
+}
+
+void Accumulator::AddProduct(const BigInteger& x, const BigInteger& y, bool negative) {
+  negative = negative != (x.is_negative_ != y.is_negative_);
+
+  const Digit* a = x.digits_.Data();
+  const Digit* b = y.digits_.Data();
+  size_t n = x.digits_.Size();
+  size_t m = y.digits_.Size();
+  if (n < m) {
+    std::swap(a, b);
+    std::swap(n, m);
+  }
+
+  Digit* res = buffer_.Data();
+  size_t len = buffer_.Size();
+
+  // Below the Karatsuba threshold the rows go straight into the accumulator, with no product buffer.
+  if (m < big_integer_kernels::Thresholds().karatsuba) {
+    for (size_t j = 0; j < m; ++j) {
+      if (negative) {
+        Digit borrow = big_integer_kernels::SubMulDigit(res + j, a, n, b[j]);
+        big_integer_kernels::SubInPlace(res + j + n, len - j - n, &borrow, 1);
+      } else {
+        Digit carry = big_integer_kernels::AddMulDigit(res + j, a, n, b[j]);
+        big_integer_kernels::AddInPlace(res + j + n, len - j - n, &carry, 1);
+      }
+    }
+    return;
+  }
+
+  DigitBuffer product;
+  product.Resize(n + m);
+  big_integer_kernels::Mul(product.Data(), a, n, b, m);
+
+  if (negative) {
+    big_integer_kernels::SubInPlace(res, len, product.Data(), n + m);
+  } else {
+    big_integer_kernels::AddInPlace(res, len, product.Data(), n + m);
+  }
+}
+
+void Accumulator::Merge(const Accumulator& other) {
+  big_integer_kernels::AddInPlace(buffer_.Data(), buffer_.Size(), other.buffer_.Data(), other.buffer_.Size());
+}
+
+BigInteger Accumulator::Finish() {
+  // Every partial sum is below B^(len - 1) in magnitude, so the top digit holds only the sign.
+  bool negative = (buffer_.Back() >> (big_integer_kernels::kDigitBits - 1)) != 0;
+  if (negative) {
+    const Digit one = 1;
+    for (Digit& digit : buffer_) {
+      digit = ~digit;
+    }
+    big_integer_kernels::AddInPlace(buffer_.Data(), buffer_.Size(), &one, 1);
+  }
+
+  BigInteger res;
+  res.digits_ = std::move(buffer_);
+  res.is_negative_ = negative;
+  res.RemoveLeadingZeros();
+  res.CheckOverflow();
+
+  return res;
+}
+
+}  // namespace big_integer_expr
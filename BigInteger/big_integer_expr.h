@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "big_integer.h"
+
+// Opt-in lazy arithmetic for BigInteger. Lazy(a) * b + Lazy(c) * d - e builds an expression tree
+// instead of a temporary per operator; converting it to BigInteger (or calling EvaluateInto) sizes
+// one destination buffer from the tree and accumulates every term into it, with products of two
+// operands fused into the accumulation.
+//
+// Only operators with an expression operand build nodes: c * d between two plain BigIntegers is
+// still evaluated eagerly by BigInteger::operator*, so every product to be fused needs a Lazy
+// factor.
+//
+// Nodes keep references to their BigInteger operands: evaluate an expression within the full
+// expression that builds it and never store one in an auto variable.
+namespace big_integer_expr {
+
+// Signed sum of terms in two's complement over a buffer that is never resized.
+class Accumulator {
+ public:
+  // Takes over the digit buffer of reuse, if given, instead of allocating.
+  Accumulator(size_t digits, BigInteger* reuse);
+
+  static size_t Size(const BigInteger& x);
+
+  void Add(const BigInteger& x, bool negative);
+  void AddProduct(const BigInteger& x, const BigInteger& y, bool negative);
+  // Adds the running total of other, which must be of the same size.
+  void Merge(const Accumulator& other);
+
+  BigInteger Finish();
+
+ private:
+  DigitBuffer buffer_;
+};
+
+template <class Derived>
+class Expression {
+ public:
+  const Derived& Self() const {
+    return static_cast<const Derived&>(*this);
+  }
+
+  BigInteger Evaluate() const {
+    BigInteger res;
+    Self().EvaluateInto(res);
+    return res;
+  }
+
+  // Evaluates into dest, reusing its digit buffer when dest is not an operand of the expression.
+  void EvaluateInto(BigInteger& dest) const {
+    Accumulator acc(Self().Bound() + 1, Self().Refers(dest) ? nullptr : &dest);
+    Self().AccumulateInto(acc, false);
+    dest = acc.Finish();
+  }
+
+  operator BigInteger() const {  // NOLINT
+    return Evaluate();
+  }
+};
+
+class Leaf : public Expression<Leaf> {
+ public:
+  explicit Leaf(const BigInteger& value) : value_(value) {
+  }
+
+  const BigInteger& Get() const {
+    return value_;
+  }
+
+  size_t Bound() const {
+    return Accumulator::Size(value_);
+  }
+
+  bool Refers(const BigInteger& x) const {
+    return &value_ == &x;
+  }
+
+  void AccumulateInto(Accumulator& acc, bool negative) const {
+    acc.Add(value_, negative);
+  }
+
+ private:
+  const BigInteger& value_;
+};
+
+template <class L, class R, bool kSubtract>
+class Sum : public Expression<Sum<L, R, kSubtract>> {
+ public:
+  Sum(const L& left, const R& right) : left_(left), right_(right) {
+  }
+
+  BigInteger Get() const {
+    return this->Evaluate();
+  }
+
+  size_t Bound() const {
+    return std::max(left_.Bound(), right_.Bound()) + 1;
+  }
+
+  bool Refers(const BigInteger& x) const {
+    return left_.Refers(x) || right_.Refers(x);
+  }
+
+  void AccumulateInto(Accumulator& acc, bool negative) const {
+    left_.AccumulateInto(acc, negative);
+    right_.AccumulateInto(acc, negative != kSubtract);
+  }
+
+ private:
+  L left_;
+  R right_;
+};
+
+template <class L, class R>
+class Product : public Expression<Product<L, R>> {
+ public:
+  Product(const L& left, const R& right) : left_(left), right_(right) {
+  }
+
+  BigInteger Get() const {
+    return this->Evaluate();
+  }
+
+  size_t Bound() const {
+    return left_.Bound() + right_.Bound();
+  }
+
+  bool Refers(const BigInteger& x) const {
+    return left_.Refers(x) || right_.Refers(x);
+  }
+
+  // Operands that are not plain values are evaluated first; the product itself is fused.
+  void AccumulateInto(Accumulator& acc, bool negative) const {
+    const BigInteger& x = left_.Get();
+    const BigInteger& y = right_.Get();
+    acc.AddProduct(x, y, negative);
+  }
+
+ private:
+  L left_;
+  R right_;
+};
+
+template <class E>
+class Negation : public Expression<Negation<E>> {
+ public:
+  explicit Negation(const E& inner) : inner_(inner) {
+  }
+
+  BigInteger Get() const {
+    return this->Evaluate();
+  }
+
+  size_t Bound() const {
+    return inner_.Bound();
+  }
+
+  bool Refers(const BigInteger& x) const {
+    return inner_.Refers(x);
+  }
+
+  void AccumulateInto(Accumulator& acc, bool negative) const {
+    inner_.AccumulateInto(acc, !negative);
+  }
+
+ private:
+  E inner_;
+};
+
+template <class L, class R>
+Sum<L, R, false> operator+(const Expression<L>& left, const Expression<R>& right) {
+  return {left.Self(), right.Self()};
+}
+
+template <class L>
+Sum<L, Leaf, false> operator+(const Expression<L>& left, const BigInteger& right) {
+  return {left.Self(), Leaf(right)};
+}
+
+template <class R>
+Sum<Leaf, R, false> operator+(const BigInteger& left, const Expression<R>& right) {
+  return {Leaf(left), right.Self()};
+}
+
+template <class L, class R>
+Sum<L, R, true> operator-(const Expression<L>& left, const Expression<R>& right) {
+  return {left.Self(), right.Self()};
+}
+
+template <class L>
+Sum<L, Leaf, true> operator-(const Expression<L>& left, const BigInteger& right) {
+  return {left.Self(), Leaf(right)};
+}
+
+template <class R>
+Sum<Leaf, R, true> operator-(const BigInteger& left, const Expression<R>& right) {
+  return {Leaf(left), right.Self()};
+}
+
+template <class L, class R>
+Product<L, R> operator*(const Expression<L>& left, const Expression<R>& right) {
+  return {left.Self(), right.Self()};
+}
+
+template <class L>
+Product<L, Leaf> operator*(const Expression<L>& left, const BigInteger& right) {
+  return {left.Self(), Leaf(right)};
+}
+
+template <class R>
+Product<Leaf, R> operator*(const BigInteger& left, const Expression<R>& right) {
+  return {Leaf(left), right.Self()};
+}
+
+template <class E>
+Negation<E> operator-(const Expression<E>& inner) {
+  return Negation<E>(inner.Self());
+}
+
+}  // namespace big_integer_expr
+
+inline big_integer_expr::Leaf Lazy(const BigInteger& value) {
+  return big_integer_expr::Leaf(value);
+}
@@ -0,0 +1,898 @@
+#include "big_integer_kernels.h"
+
+#include "big_integer_simd.h"
+#include "big_integer_stats.h"
+#include "digit_allocator.h"
+#include "digit_buffer.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace big_integer_kernels {
+
+namespace {
+
+using big_integer_stats::Operation;
+
+const size_t kMinKaratsubaSize = 4;
+const size_t kMinToom3Size = 12;
+
+// Butterflies per task of a parallel NTT pass.
+const size_t kNttTaskSize = size_t{1} << 14;
+
+std::unique_ptr<ThreadPool>& Pool() {
+  static std::unique_ptr<ThreadPool> pool;
+  return pool;
+}
+
+// Whether a product whose shorter operand has m digits fans out across the pool.
+bool Parallel(size_t m) {
+  return Pool() != nullptr && m >= Thresholds().parallel;
+}
+
+// Runs body(0), ..., body(count - 1), on the pool when parallel is set. Only then is body
+// wrapped in a std::function, so the serial path does not allocate.
+template <class Body>
+void ForEach(bool parallel, size_t count, const Body& body) {
+  if (parallel) {
+    Pool()->ParallelFor(count, std::function<void(size_t)>(body));
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      body(i);
+    }
+  }
+}
+
+struct SignedDigits {
+  ScratchVector<Digit> digits;
+  bool is_negative = false;
+};
+
+SignedDigits Slice(const Digit* a, size_t n, size_t from, size_t len) {
+  SignedDigits res;
+  if (from < n) {
+    len = Normalized(a + from, std::min(len, n - from));
+    res.digits.assign(a + from, a + from + len);
+  }
+  return res;
+}
+
+void Trim(SignedDigits& x) {
+  x.digits.resize(Normalized(x.digits.data(), x.digits.size()));
+  if (x.digits.empty()) {
+    x.is_negative = false;
+  }
+}
+
+SignedDigits SignedAdd(const SignedDigits& x, const SignedDigits& y, bool negate_y = false) {
+  bool y_negative = y.is_negative != negate_y;
+  const SignedDigits* big = &x;
+  const SignedDigits* small = &y;
+  bool small_negative = y_negative;
+  bool big_negative = x.is_negative;
+
+  if (x.is_negative != y_negative &&
+      Compare(x.digits.data(), x.digits.size(), y.digits.data(), y.digits.size()) < 0) {
+    std::swap(big, small);
+    std::swap(big_negative, small_negative);
+  } else if (x.digits.size() < y.digits.size()) {
+    std::swap(big, small);
+    std::swap(big_negative, small_negative);
+  }
+
+  SignedDigits res;
+  res.digits = big->digits;
+  res.is_negative = big_negative;
+
+  if (big_negative == small_negative) {
+    res.digits.push_back(0);
+    AddInPlace(res.digits.data(), res.digits.size(), small->digits.data(), small->digits.size());
+  } else {
+    SubInPlace(res.digits.data(), res.digits.size(), small->digits.data(), small->digits.size());
+  }
+
+  Trim(res);
+  return res;
+}
+
+SignedDigits SignedSub(const SignedDigits& x, const SignedDigits& y) {
+  return SignedAdd(x, y, true);
+}
+
+SignedDigits SignedMul(const SignedDigits& x, const SignedDigits& y) {
+  SignedDigits res;
+  if (x.digits.empty() || y.digits.empty()) {
+    return res;
+  }
+
+  res.digits.resize(x.digits.size() + y.digits.size());
+  Mul(res.digits.data(), x.digits.data(), x.digits.size(), y.digits.data(), y.digits.size());
+  res.is_negative = x.is_negative != y.is_negative;
+  Trim(res);
+  return res;
+}
+
+SignedDigits Twice(const SignedDigits& x) {
+  SignedDigits res = x;
+  res.digits.push_back(0);
+  AddInPlace(res.digits.data(), res.digits.size(), x.digits.data(), x.digits.size());
+  Trim(res);
+  return res;
+}
+
+SignedDigits DivideExact(const SignedDigits& x, Digit divisor) {
+  SignedDigits res = x;
+  DoubleDigit remainder = 0;
+
+  for (size_t i = res.digits.size(); i-- > 0;) {
+    DoubleDigit cur = (remainder << kDigitBits) | res.digits[i];
+    res.digits[i] = static_cast<Digit>(cur / divisor);
+    remainder = cur % divisor;
+  }
+
+  Trim(res);
+  return res;
+}
+
+// Values of a0 + a1 * x + a2 * x^2 at x = 0, 1, -1, -2 and infinity.
+void Evaluate(const Digit* a, size_t n, size_t k, SignedDigits (&values)[5]) {
+  SignedDigits a0 = Slice(a, n, 0, k);
+  SignedDigits a1 = Slice(a, n, k, k);
+  SignedDigits a2 = Slice(a, n, 2 * k, k);
+
+  SignedDigits even = SignedAdd(a0, a2);
+  values[1] = SignedAdd(even, a1);
+  values[2] = SignedSub(even, a1);
+  values[3] = SignedSub(Twice(SignedAdd(values[2], a2)), a0);
+  values[0] = std::move(a0);
+  values[4] = std::move(a2);
+}
+
+// Primes of the form c * 2^k + 1 with primitive root 3. The transform works on 16-bit halves
+// of digits, so it is at most 2 * kMaxNttDigits long and every convolution term is below
+// 2^32 * 2 * kMaxNttDigits = 2^55, far below the product of the three moduli, and the Garner
+// reconstruction fits in 64 bits.
+const uint32_t kNttModulus0 = 998244353;
+const uint32_t kNttModulus1 = 167772161;
+const uint32_t kNttModulus2 = 469762049;
+const uint32_t kNttRoot = 3;
+static_assert((kNttModulus0 - 1) % (2 * kMaxNttDigits) == 0, "kNttModulus0 has roots for every transform length");
+
+template <uint32_t kModulus>
+uint32_t MulMod(uint32_t a, uint32_t b) {
+  return static_cast<uint32_t>(static_cast<uint64_t>(a) * b % kModulus);
+}
+
+template <uint32_t kModulus>
+uint32_t PowMod(uint32_t base, uint64_t exponent) {
+  uint32_t res = 1;
+  for (; exponent != 0; exponent >>= 1) {
+    if (exponent & 1) {
+      res = MulMod<kModulus>(res, base);
+    }
+    base = MulMod<kModulus>(base, base);
+  }
+  return res;
+}
+
+// Montgomery product a * b / 2^32 mod kModulus; avoids the 64-bit division in the butterflies.
+template <uint32_t kModulus>
+uint32_t MontgomeryMul(uint32_t a, uint32_t b) {
+  uint32_t inverse = kModulus;
+  for (int i = 0; i < 4; ++i) {
+    inverse *= 2 - kModulus * inverse;
+  }
+
+  uint64_t product = static_cast<uint64_t>(a) * b;
+  uint32_t correction = static_cast<uint32_t>(product) * (0 - inverse);
+  uint32_t res = static_cast<uint32_t>((product + static_cast<uint64_t>(correction) * kModulus) >> 32);
+  return res >= kModulus ? res - kModulus : res;
+}
+
+template <uint32_t kModulus>
+uint32_t ToMontgomery(uint32_t a) {
+  return static_cast<uint32_t>((static_cast<uint64_t>(a) << 32) % kModulus);
+}
+
+// Unscaled transform: the inverse direction leaves the result multiplied by a.size().
+template <uint32_t kModulus>
+void Ntt(ScratchVector<uint32_t>& a, bool invert, bool parallel) {
+  size_t n = a.size();
+
+  for (size_t i = 1, j = 0; i < n; ++i) {
+    size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      std::swap(a[i], a[j]);
+    }
+  }
+
+  ScratchVector<uint32_t> roots(n / 2);
+  for (size_t len = 2; len <= n; len <<= 1) {
+    uint32_t step = PowMod<kModulus>(kNttRoot, (kModulus - 1) / len);
+    if (invert) {
+      step = PowMod<kModulus>(step, kModulus - 2);
+    }
+
+    size_t half = len / 2;
+    uint32_t root = 1;
+    for (size_t j = 0; j < half; ++j) {
+      roots[j] = ToMontgomery<kModulus>(root);
+      root = MulMod<kModulus>(root, step);
+    }
+
+    // Butterfly t pairs a[i + j] with a[i + j + half] for i = t / half * len and j = t % half.
+    uint32_t* data = a.data();
+    const uint32_t* powers = roots.data();
+    auto butterflies = [data, powers, half, len](size_t from, size_t to) {
+      for (size_t t = from; t < to;) {
+        uint32_t* block = data + t / half * len;
+        size_t begin = t % half;
+        size_t end = std::min(half, begin + (to - t));
+        for (size_t j = begin; j < end; ++j) {
+          uint32_t u = block[j];
+          uint32_t v = MontgomeryMul<kModulus>(block[j + half], powers[j]);
+          block[j] = u + v < kModulus ? u + v : u + v - kModulus;
+          block[j + half] = u >= v ? u - v : u + kModulus - v;
+        }
+        t += end - begin;
+      }
+    };
+
+    size_t count = n / 2;
+    size_t tasks = (count + kNttTaskSize - 1) / kNttTaskSize;
+    ForEach(parallel && tasks > 1, tasks, [&](size_t task) {
+      butterflies(task * kNttTaskSize, std::min(count, (task + 1) * kNttTaskSize));
+    });
+  }
+}
+
+// Cyclic convolution of a and b modulo kModulus; both are taken by value and reused as buffers.
+// In parallel mode the two forward transforms run side by side and every pass is split up.
+template <uint32_t kModulus>
+ScratchVector<uint32_t> Convolve(ScratchVector<uint32_t> a, ScratchVector<uint32_t> b, bool square, bool parallel) {
+  if (square) {
+    Ntt<kModulus>(a, false, parallel);
+    for (uint32_t& x : a) {
+      x = MontgomeryMul<kModulus>(x, x);
+    }
+  } else {
+    ForEach(parallel, 2, [&](size_t i) {
+      Ntt<kModulus>(i == 0 ? a : b, false, parallel);
+    });
+    for (size_t i = 0; i < a.size(); ++i) {
+      a[i] = MontgomeryMul<kModulus>(a[i], b[i]);
+    }
+  }
+  Ntt<kModulus>(a, true, parallel);
+
+  // The pointwise Montgomery products left a factor of 2^-32 and the inverse transform one of n.
+  uint32_t inverse_n = PowMod<kModulus>(static_cast<uint32_t>(a.size() % kModulus), kModulus - 2);
+  uint32_t scale = ToMontgomery<kModulus>(ToMontgomery<kModulus>(inverse_n));
+  for (uint32_t& x : a) {
+    x = MontgomeryMul<kModulus>(x, scale);
+  }
+  return a;
+}
+
+ScratchVector<uint32_t> SplitHalves(const Digit* a, size_t n, size_t length) {
+  ScratchVector<uint32_t> halves(length, 0);
+  for (size_t i = 0; i < n; ++i) {
+    halves[2 * i] = a[i] & 0xFFFF;
+    halves[2 * i + 1] = a[i] >> 16;
+  }
+  return halves;
+}
+
+int LeadingZeros(Digit x) {
+  int count = 0;
+  for (Digit bit = Digit{1} << (kDigitBits - 1); bit != 0 && (x & bit) == 0; bit >>= 1) {
+    ++count;
+  }
+  return count;
+}
+
+void MulUnbalanced(Digit* res, const Digit* a, size_t n, const Digit* b, size_t m) {
+  std::fill(res, res + n + m, 0);
+
+  if (Parallel(m)) {
+    // Every chunk gets its own product buffer; the additions stay in order.
+    size_t chunks = (n + m - 1) / m;
+    ScratchVector<Digit> parts(chunks * 2 * m);
+    ForEach(true, chunks, [&](size_t c) {
+      Mul(parts.data() + c * 2 * m, a + c * m, std::min(m, n - c * m), b, m);
+    });
+    for (size_t c = 0; c < chunks; ++c) {
+      AddInPlace(res + c * m, n + m - c * m, parts.data() + c * 2 * m, std::min(m, n - c * m) + m);
+    }
+    return;
+  }
+
+  ScratchVector<Digit> part(2 * m);
+  for (size_t i = 0; i < n; i += m) {
+    size_t len = std::min(m, n - i);
+    Mul(part.data(), a + i, len, b, m);
+    AddInPlace(res + i, n + m - i, part.data(), len + m);
+  }
+}
+
+const Digit kOne = 1;
+const size_t kReciprocalBaseCase = 16;
+
+// floor((B^(2t) - 1) / d) up to a few units, t + 1 digits, for d[0, t) with the top bit set.
+ScratchVector<Digit> Reciprocal(const Digit* d, size_t t) {
+  ScratchVector<Digit> x(t + 1, 0);
+
+  if (t <= kReciprocalBaseCase) {
+    ScratchVector<Digit> all_ones(2 * t, ~Digit{0});
+    ScratchVector<Digit> remainder(t);
+    DivModKnuth(x.data(), remainder.data(), all_ones.data(), 2 * t, d, t);
+    return x;
+  }
+
+  // Start from the reciprocal of the top k digits, x0 = xh * B^(t - k), and take one Newton
+  // step x1 = x0 + x0 * (B^(2t) - d * x0) / B^(2t), which doubles the number of correct digits.
+  // In terms of xh the step is x0 + xh * e / B^(2k) with e = B^(t + k) - d * xh.
+  size_t k = t / 2 + 1;
+  ScratchVector<Digit> xh = Reciprocal(d + (t - k), k);
+  std::copy(xh.begin(), xh.end(), x.begin() + (t - k));
+
+  ScratchVector<Digit> error(t + k + 1);
+  Mul(error.data(), d, t, xh.data(), k + 1);
+  bool below = error[t + k] == 0;
+  if (below) {
+    for (size_t i = 0; i < t + k; ++i) {
+      error[i] = ~error[i];
+    }
+    AddInPlace(error.data(), t + k, &kOne, 1);
+  } else {
+    --error[t + k];
+  }
+
+  size_t error_len = Normalized(error.data(), error.size());
+  ScratchVector<Digit> correction(error_len + k + 1);
+  Mul(correction.data(), error.data(), error_len, xh.data(), k + 1);
+
+  if (correction.size() > 2 * k) {
+    const Digit* high = correction.data() + 2 * k;
+    size_t high_len = Normalized(high, correction.size() - 2 * k);
+    if (below) {
+      AddInPlace(x.data(), x.size(), high, high_len);
+    } else {
+      SubInPlace(x.data(), x.size(), high, high_len);
+    }
+  }
+
+  return x;
+}
+
+// q[0, m) = a[0, n) / b[0, m) and r[0, m) = a % b, where x is the approximate reciprocal of b,
+// b has its top bit set, n <= 2m and a < b * B^m.
+void DivModWithReciprocal(Digit* q, Digit* r, const Digit* a, size_t n, const Digit* b, size_t m,
+                          const ScratchVector<Digit>& x) {
+  // The estimate floor(floor(a / B^(m - 1)) * x / B^(m + 1)) is within a few units of the quotient.
+  ScratchVector<Digit> estimate(m + 1, 0);
+  if (n >= m) {
+    ScratchVector<Digit> product(n - m + 1 + m + 1);
+    Mul(product.data(), a + (m - 1), n - m + 1, x.data(), m + 1);
+    std::copy(product.begin() + m + 1, product.begin() + std::min(product.size(), 2 * m + 2), estimate.begin());
+  }
+
+  ScratchVector<Digit> back(2 * m + 1);
+  Mul(back.data(), estimate.data(), m + 1, b, m);
+  while (Compare(back.data(), back.size(), a, n) > 0) {
+    SubInPlace(estimate.data(), estimate.size(), &kOne, 1);
+    SubInPlace(back.data(), back.size(), b, m);
+  }
+
+  ScratchVector<Digit> rem(a, a + n);
+  SubInPlace(rem.data(), n, back.data(), Normalized(back.data(), back.size()));
+  while (Compare(rem.data(), n, b, m) >= 0) {
+    SubInPlace(rem.data(), n, b, m);
+    AddInPlace(estimate.data(), estimate.size(), &kOne, 1);
+  }
+
+  std::copy(estimate.begin(), estimate.begin() + m, q);
+  std::fill(r, r + m, 0);
+  std::copy(rem.begin(), rem.begin() + std::min(n, m), r);
+}
+
+}  // namespace
+
+MultiplicationThresholds& Thresholds() {
+  static MultiplicationThresholds thresholds{40, 400, 50000, 2000};
+  return thresholds;
+}
+
+size_t ThreadCount() {
+  return Pool() != nullptr ? Pool()->Size() : 1;
+}
+
+void SetThreadCount(size_t threads) {
+  Pool().reset(threads > 1 ? new ThreadPool(threads) : nullptr);
+}
+
+void ParallelFor(size_t count, const std::function<void(size_t)>& body) {
+  ForEach(Pool() != nullptr, count, body);
+}
+
+size_t Normalized(const Digit* a, size_t n) {
+  while (n > 0 && a[n - 1] == 0) {
+    --n;
+  }
+  return n;
+}
+
+int Compare(const Digit* a, size_t n, const Digit* b, size_t m) {
+  n = Normalized(a, n);
+  m = Normalized(b, m);
+
+  if (n != m) {
+    return n < m ? -1 : 1;
+  }
+
+  size_t i = big_integer_simd::HighestDifference(a, b, n);
+  if (i == 0) {
+    return 0;
+  }
+  return a[i - 1] < b[i - 1] ? -1 : 1;
+}
+
+Digit AddInPlace(Digit* a, size_t n, const Digit* b, size_t m) {
+  Digit carry = big_integer_simd::AddDigits(a, b, m, 0);
+  size_t i = m;
+
+  for (; carry != 0 && i < n; ++i) {
+    carry = ++a[i] == 0;
+  }
+
+  return carry;
+}
+
+Digit SubInPlace(Digit* a, size_t n, const Digit* b, size_t m) {
+  Digit borrow = big_integer_simd::SubDigits(a, b, m, 0);
+  size_t i = m;
+
+  for (; borrow != 0 && i < n; ++i) {
+    borrow = a[i]-- == 0;
+  }
+
+  return borrow;
+}
+
+Digit SubFromInPlace(Digit* a, const Digit* b, size_t n) {
+  Digit borrow = 0;
+
+  for (size_t i = 0; i < n; ++i) {
+    DoubleDigit diff = static_cast<DoubleDigit>(b[i]) - a[i] - borrow;
+    a[i] = static_cast<Digit>(diff);
+    borrow = static_cast<Digit>(diff >> kDigitBits) & 1;
+  }
+
+  return borrow;
+}
+
+Digit MulDigitInPlace(Digit* a, size_t n, Digit d) {
+  DoubleDigit carry = 0;
+
+  for (size_t i = 0; i < n; ++i) {
+    DoubleDigit cur = static_cast<DoubleDigit>(a[i]) * d + carry;
+    a[i] = static_cast<Digit>(cur);
+    carry = cur >> kDigitBits;
+  }
+
+  return static_cast<Digit>(carry);
+}
+
+Digit AddMulDigit(Digit* res, const Digit* a, size_t n, Digit d) {
+  DoubleDigit carry = 0;
+
+  for (size_t i = 0; i < n; ++i) {
+    DoubleDigit cur = res[i] + static_cast<DoubleDigit>(a[i]) * d + carry;
+    res[i] = static_cast<Digit>(cur);
+    carry = cur >> kDigitBits;
+  }
+
+  return static_cast<Digit>(carry);
+}
+
+Digit SubMulDigit(Digit* res, const Digit* a, size_t n, Digit d) {
+  DoubleDigit borrow = 0;
+
+  for (size_t i = 0; i < n; ++i) {
+    DoubleDigit product = static_cast<DoubleDigit>(a[i]) * d + borrow;
+    Digit low = static_cast<Digit>(product);
+    borrow = (product >> kDigitBits) + (res[i] < low);
+    res[i] -= low;
+  }
+
+  return static_cast<Digit>(borrow);
+}
+
+Digit ShiftLeft(Digit* res, const Digit* a, size_t n, int shift) {
+  if (n == 0 || shift == 0) {
+    if (res != a) {
+      std::copy(a, a + n, res);
+    }
+    return 0;
+  }
+
+  Digit out = a[n - 1] >> (kDigitBits - shift);
+  for (size_t i = n; i-- > 1;) {
+    res[i] = (a[i] << shift) | (a[i - 1] >> (kDigitBits - shift));
+  }
+  res[0] = a[0] << shift;
+
+  return out;
+}
+
+Digit ShiftRight(Digit* res, const Digit* a, size_t n, int shift) {
+  if (n == 0 || shift == 0) {
+    if (res != a) {
+      std::copy(a, a + n, res);
+    }
+    return 0;
+  }
+
+  Digit out = a[0] << (kDigitBits - shift);
+  for (size_t i = 0; i + 1 < n; ++i) {
+    res[i] = (a[i] >> shift) | (a[i + 1] << (kDigitBits - shift));
+  }
+  res[n - 1] = a[n - 1] >> shift;
+
+  return out;
+}
+
+void MulSchoolbook(Digit* res, const Digit* a, size_t n, const Digit* b, size_t m) {
+  std::fill(res, res + n + m, 0);
+
+  for (size_t i = 0; i < n; ++i) {
+    DoubleDigit carry = 0;
+    for (size_t j = 0; j < m; ++j) {
+      DoubleDigit cur = res[i + j] + static_cast<DoubleDigit>(a[i]) * b[j] + carry;
+      res[i + j] = static_cast<Digit>(cur);
+      carry = cur >> kDigitBits;
+    }
+    res[i + m] = static_cast<Digit>(carry);
+  }
+}
+
+void SqrSchoolbook(Digit* res, const Digit* a, size_t n) {
+  std::fill(res, res + 2 * n, 0);
+
+  // Each product a[i] * a[j] with i < j once, doubled, plus the squares on the diagonal.
+  for (size_t i = 0; i < n; ++i) {
+    DoubleDigit carry = 0;
+    for (size_t j = i + 1; j < n; ++j) {
+      DoubleDigit cur = res[i + j] + static_cast<DoubleDigit>(a[i]) * a[j] + carry;
+      res[i + j] = static_cast<Digit>(cur);
+      carry = cur >> kDigitBits;
+    }
+    res[i + n] = static_cast<Digit>(carry);
+  }
+  ShiftLeft(res, res, 2 * n, 1);
+
+  DoubleDigit carry = 0;
+  for (size_t i = 0; i < n; ++i) {
+    DoubleDigit square = static_cast<DoubleDigit>(a[i]) * a[i];
+    DoubleDigit low = res[2 * i] + (square & ~Digit{0}) + carry;
+    res[2 * i] = static_cast<Digit>(low);
+    DoubleDigit high = res[2 * i + 1] + (square >> kDigitBits) + (low >> kDigitBits);
+    res[2 * i + 1] = static_cast<Digit>(high);
+    carry = high >> kDigitBits;
+  }
+}
+
+void MulKaratsuba(Digit* res, const Digit* a, size_t n, const Digit* b, size_t m) {
+  if (n < m) {
+    std::swap(a, b);
+    std::swap(n, m);
+  }
+
+  size_t half = (n + 1) / 2;
+  if (m < kMinKaratsubaSize) {
+    MulSchoolbook(res, a, n, b, m);
+    return;
+  }
+  if (m <= half) {
+    MulUnbalanced(res, a, n, b, m);
+    return;
+  }
+
+  // res = z0 + (z1 - z0 - z2) * B^half + z2 * B^(2 * half), where z0 and z2 are the
+  // products of the low and high halves and z1 the product of the half sums. The three
+  // products write to disjoint memory and may run concurrently. Squares stay squares.
+  bool square = a == b && n == m;
+  ScratchVector<Digit> sum_a(a, a + half);
+  sum_a.push_back(AddInPlace(sum_a.data(), half, a + half, n - half));
+  size_t len_a = Normalized(sum_a.data(), sum_a.size());
+
+  ScratchVector<Digit> sum_b;
+  if (!square) {
+    sum_b.assign(b, b + half);
+    sum_b.push_back(AddInPlace(sum_b.data(), half, b + half, m - half));
+  }
+  const ScratchVector<Digit>& other_sum = square ? sum_a : sum_b;
+  size_t len_b = Normalized(other_sum.data(), other_sum.size());
+
+  ScratchVector<Digit> middle(2 * half + 2, 0);
+  ForEach(Parallel(m), 3, [&](size_t i) {
+    if (i == 0) {
+      Mul(res, a, half, b, half);
+    } else if (i == 1) {
+      Mul(res + 2 * half, a + half, n - half, b + half, m - half);
+    } else {
+      Mul(middle.data(), sum_a.data(), len_a, other_sum.data(), len_b);
+    }
+  });
+  SubInPlace(middle.data(), middle.size(), res, 2 * half);
+  SubInPlace(middle.data(), middle.size(), res + 2 * half, n + m - 2 * half);
+  AddInPlace(res + half, n + m - half, middle.data(), Normalized(middle.data(), middle.size()));
+}
+
+void MulToom3(Digit* res, const Digit* a, size_t n, const Digit* b, size_t m) {
+  if (n < m) {
+    std::swap(a, b);
+    std::swap(n, m);
+  }
+
+  if (m < kMinToom3Size) {
+    MulKaratsuba(res, a, n, b, m);
+    return;
+  }
+  if (2 * m <= n) {
+    MulUnbalanced(res, a, n, b, m);
+    return;
+  }
+
+  // Evaluation at 0, 1, -1, -2, infinity and Bodrato's interpolation sequence.
+  size_t k = (n + 2) / 3;
+  bool square = a == b && n == m;
+  SignedDigits values_a[5];
+  SignedDigits values_b[5];
+  Evaluate(a, n, k, values_a);
+  if (!square) {
+    Evaluate(b, m, k, values_b);
+  }
+
+  SignedDigits r[5];
+  ForEach(Parallel(m), 5, [&](size_t i) {
+    r[i] = SignedMul(values_a[i], square ? values_a[i] : values_b[i]);
+  });
+
+  SignedDigits r3 = DivideExact(SignedSub(r[3], r[1]), 3);
+  SignedDigits r1 = DivideExact(SignedSub(r[1], r[2]), 2);
+  SignedDigits r2 = SignedSub(r[2], r[0]);
+  r3 = SignedAdd(DivideExact(SignedSub(r2, r3), 2), Twice(r[4]));
+  r2 = SignedSub(SignedAdd(r2, r1), r[4]);
+  r1 = SignedSub(r1, r3);
+
+  const SignedDigits* coefficients[5] = {&r[0], &r1, &r2, &r3, &r[4]};
+  std::fill(res, res + n + m, 0);
+  for (size_t i = 0; i < 5; ++i) {
+    const ScratchVector<Digit>& digits = coefficients[i]->digits;
+    AddInPlace(res + i * k, n + m - i * k, digits.data(), digits.size());
+  }
+}
+
+void MulNtt(Digit* res, const Digit* a, size_t n, const Digit* b, size_t m) {
+  if (n + m > kMaxNttDigits) {
+    MulToom3(res, a, n, b, m);
+    return;
+  }
+
+  size_t length = 1;
+  while (length < 2 * (n + m)) {
+    length <<= 1;
+  }
+
+  // One independent convolution per prime; each splits the operands into its own buffers.
+  bool square = a == b && n == m;
+  bool parallel = Parallel(m);
+  ScratchVector<uint32_t> r0;
+  ScratchVector<uint32_t> r1;
+  ScratchVector<uint32_t> r2;
+  ForEach(parallel, 3, [&](size_t prime) {
+    ScratchVector<uint32_t> halves_a = SplitHalves(a, n, length);
+    ScratchVector<uint32_t> halves_b = square ? ScratchVector<uint32_t>() : SplitHalves(b, m, length);
+    if (prime == 0) {
+      r0 = Convolve<kNttModulus0>(std::move(halves_a), std::move(halves_b), square, parallel);
+    } else if (prime == 1) {
+      r1 = Convolve<kNttModulus1>(std::move(halves_a), std::move(halves_b), square, parallel);
+    } else {
+      r2 = Convolve<kNttModulus2>(std::move(halves_a), std::move(halves_b), square, parallel);
+    }
+  });
+
+  const uint32_t inverse01 = PowMod<kNttModulus1>(kNttModulus0 % kNttModulus1, kNttModulus1 - 2);
+  const uint32_t inverse012 =
+      PowMod<kNttModulus2>(MulMod<kNttModulus2>(kNttModulus0 % kNttModulus2, kNttModulus1), kNttModulus2 - 2);
+
+  uint64_t carry = 0;
+  for (size_t i = 0; i < 2 * (n + m); ++i) {
+    // Garner: x = r0 + p0 * (t1 + p1 * t2).
+    uint32_t t1 = MulMod<kNttModulus1>((r1[i] + kNttModulus1 - r0[i] % kNttModulus1) % kNttModulus1, inverse01);
+    uint32_t t2 = (r2[i] + kNttModulus2 - r0[i] % kNttModulus2) % kNttModulus2;
+    t2 = (t2 + kNttModulus2 - MulMod<kNttModulus2>(kNttModulus0 % kNttModulus2, t1)) % kNttModulus2;
+    t2 = MulMod<kNttModulus2>(t2, inverse012);
+
+    carry += r0[i] + static_cast<uint64_t>(kNttModulus0) * (t1 + static_cast<uint64_t>(kNttModulus1) * t2);
+    if (i % 2 == 0) {
+      res[i / 2] = static_cast<Digit>(carry & 0xFFFF);
+    } else {
+      res[i / 2] |= static_cast<Digit>(carry & 0xFFFF) << 16;
+    }
+    carry >>= 16;
+  }
+}
+
+void Mul(Digit* res, const Digit* a, size_t n, const Digit* b, size_t m) {
+  if (n < m) {
+    std::swap(a, b);
+    std::swap(n, m);
+  }
+
+  const MultiplicationThresholds& thresholds = Thresholds();
+  if (m < std::max(thresholds.karatsuba, kMinKaratsubaSize)) {
+    if (a == b && n == m) {
+      BIG_INTEGER_STATS_OPERATION(Operation::kSqrSchoolbook, m);
+      SqrSchoolbook(res, a, n);
+    } else {
+      BIG_INTEGER_STATS_OPERATION(Operation::kMulSchoolbook, m);
+      MulSchoolbook(res, a, n, b, m);
+    }
+  } else if (m >= thresholds.ntt && n + m <= kMaxNttDigits) {
+    BIG_INTEGER_STATS_OPERATION(Operation::kMulNtt, m);
+    MulNtt(res, a, n, b, m);
+  } else if (2 * m <= n) {
+    BIG_INTEGER_STATS_OPERATION(Operation::kMulUnbalanced, m);
+    MulUnbalanced(res, a, n, b, m);
+  } else if (m < std::max(thresholds.toom3, kMinToom3Size)) {
+    BIG_INTEGER_STATS_OPERATION(Operation::kMulKaratsuba, m);
+    MulKaratsuba(res, a, n, b, m);
+  } else {
+    BIG_INTEGER_STATS_OPERATION(Operation::kMulToom3, m);
+    MulToom3(res, a, n, b, m);
+  }
+}
+
+void Sqr(Digit* res, const Digit* a, size_t n) {
+  Mul(res, a, n, a, n);
+}
+
+Digit DivModDigit(Digit* q, const Digit* a, size_t n, Digit d) {
+  DoubleDigit remainder = 0;
+
+  for (size_t i = n; i-- > 0;) {
+    DoubleDigit cur = (remainder << kDigitBits) | a[i];
+    q[i] = static_cast<Digit>(cur / d);
+    remainder = cur % d;
+  }
+
+  return static_cast<Digit>(remainder);
+}
+
+void DivModKnuth(Digit* q, Digit* r, const Digit* a, size_t n, const Digit* b, size_t m) {
+  DigitBuffer v;
+  DigitBuffer u;
+  v.Resize(m);
+  u.Resize(n + 1);
+  DivModKnuth(q, r, a, n, b, m, u.Data(), v.Data());
+}
+
+void DivModKnuth(Digit* q, Digit* r, const Digit* a, size_t n, const Digit* b, size_t m, Digit* u, Digit* v) {
+  // Knuth, TAOCP vol. 2, 4.3.1, Algorithm D, on operands shifted so that the top bit of b is set.
+  int shift = LeadingZeros(b[m - 1]);
+  ShiftLeft(v, b, m, shift);
+  u[n] = ShiftLeft(u, a, n, shift);
+
+  const DoubleDigit base = DoubleDigit{1} << kDigitBits;
+  for (size_t j = n - m + 1; j-- > 0;) {
+    DoubleDigit numerator = (static_cast<DoubleDigit>(u[j + m]) << kDigitBits) | u[j + m - 1];
+    DoubleDigit qhat = numerator / v[m - 1];
+    DoubleDigit rhat = numerator % v[m - 1];
+
+    while (qhat >= base || qhat * v[m - 2] > ((rhat << kDigitBits) | u[j + m - 2])) {
+      --qhat;
+      rhat += v[m - 1];
+      if (rhat >= base) {
+        break;
+      }
+    }
+
+    int64_t borrow = 0;
+    for (size_t i = 0; i < m; ++i) {
+      DoubleDigit product = qhat * v[i];
+      int64_t cur = static_cast<int64_t>(u[i + j]) - borrow - static_cast<int64_t>(product & 0xFFFFFFFF);
+      u[i + j] = static_cast<Digit>(cur);
+      borrow = static_cast<int64_t>(product >> kDigitBits) - (cur >> kDigitBits);
+    }
+    int64_t top = static_cast<int64_t>(u[j + m]) - borrow;
+    u[j + m] = static_cast<Digit>(top);
+
+    // qhat was one too large: add b back, the carry out cancels the borrow.
+    if (top < 0) {
+      --qhat;
+      AddInPlace(u + j, m + 1, v, m);
+    }
+
+    q[j] = static_cast<Digit>(qhat);
+  }
+
+  ShiftRight(r, u, m, shift);
+}
+
+void DivModNewton(Digit* q, Digit* r, const Digit* a, size_t n, const Digit* b, size_t m) {
+  int shift = LeadingZeros(b[m - 1]);
+  ScratchVector<Digit> bn(m);
+  ScratchVector<Digit> an(n + 1);
+  ShiftLeft(bn.data(), b, m, shift);
+  an[n] = ShiftLeft(an.data(), a, n, shift);
+
+  size_t q_len = n - m + 1;
+  size_t an_len = std::max(Normalized(an.data(), an.size()), m);
+  size_t k = an_len - m;
+  ScratchVector<Digit> rem(m, 0);
+  std::fill(q, q + q_len, 0);
+
+  if (m > k + 2) {
+    // The quotient has at most k + 1 digits, so the top k + 2 digits of the divisor determine
+    // it up to one unit.
+    size_t skip = m - (k + 2);
+    ScratchVector<Digit> q_top(k + 1);
+    ScratchVector<Digit> r_top(k + 2);
+    DivMod(q_top.data(), r_top.data(), an.data() + skip, an_len - skip, bn.data() + skip, k + 2);
+
+    ScratchVector<Digit> product(an_len + 1);
+    Mul(product.data(), q_top.data(), k + 1, bn.data(), m);
+    if (Compare(product.data(), product.size(), an.data(), an_len) > 0) {
+      SubInPlace(q_top.data(), q_top.size(), &kOne, 1);
+      SubInPlace(product.data(), product.size(), bn.data(), m);
+    }
+
+    SubInPlace(an.data(), an_len, product.data(), Normalized(product.data(), product.size()));
+    std::copy(an.begin(), an.begin() + m, rem.begin());
+    std::copy(q_top.begin(), q_top.begin() + std::min(q_top.size(), q_len), q);
+  } else {
+    // Long division in base B^m, each step a multiplication by the reciprocal.
+    ScratchVector<Digit> x = Reciprocal(bn.data(), m);
+    ScratchVector<Digit> cur(2 * m);
+    ScratchVector<Digit> q_chunk(m);
+
+    for (size_t chunk = (an_len + m - 1) / m; chunk-- > 0;) {
+      size_t from = chunk * m;
+      size_t len = std::min(m, an_len - from);
+      std::copy(an.begin() + from, an.begin() + from + len, cur.begin());
+      std::copy(rem.begin(), rem.end(), cur.begin() + len);
+
+      DivModWithReciprocal(q_chunk.data(), rem.data(), cur.data(), Normalized(cur.data(), len + m), bn.data(), m, x);
+      for (size_t i = 0; i < m && from + i < q_len; ++i) {
+        q[from + i] = q_chunk[i];
+      }
+    }
+  }
+
+  ShiftRight(r, rem.data(), m, shift);
+}
+
+void DivMod(Digit* q, Digit* r, const Digit* a, size_t n, const Digit* b, size_t m) {
+  if (m == 1) {
+    BIG_INTEGER_STATS_OPERATION(Operation::kDivModDigit, m);
+    r[0] = DivModDigit(q, a, n, b[0]);
+  } else if (m >= kNewtonDivisionThreshold && n - m >= kNewtonDivisionThreshold) {
+    BIG_INTEGER_STATS_OPERATION(Operation::kDivModNewton, m);
+    DivModNewton(q, r, a, n, b, m);
+  } else {
+    BIG_INTEGER_STATS_OPERATION(Operation::kDivModKnuth, m);
+    DivModKnuth(q, r, a, n, b, m);
+  }
+}
+
+}  // namespace big_integer_kernels
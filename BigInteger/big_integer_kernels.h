@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Low-level routines on little-endian digit spans shared by BigInteger and its helpers.
+// Unless stated otherwise, outputs must not overlap inputs.
+namespace big_integer_kernels {
+
+using Digit = uint32_t;
+using DoubleDigit = uint64_t;
+const int kDigitBits = 32;
+
+struct MultiplicationThresholds {
+  size_t karatsuba;
+  size_t toom3;
+  size_t ntt;
+  // From this size on, the independent sub-products and NTT passes run on the thread pool.
+  size_t parallel;
+};
+
+MultiplicationThresholds& Thresholds();
+
+// Threads used by multiplication, counting the caller. The default of 1 keeps all work on the
+// calling thread; the products are identical either way. Not synchronised with running products.
+size_t ThreadCount();
+void SetThreadCount(size_t threads);
+
+// Runs body(0), ..., body(count - 1) on those threads, or in order on the caller with one. An
+// exception thrown by body reaches the caller once every started call has finished.
+void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+size_t Normalized(const Digit* a, size_t n);
+
+int Compare(const Digit* a, size_t n, const Digit* b, size_t m);
+
+// a[0, n) += b[0, m), n >= m; returns the carry out of a[n - 1]. Safe when a == b.
+Digit AddInPlace(Digit* a, size_t n, const Digit* b, size_t m);
+
+// a[0, n) -= b[0, m), n >= m; returns the borrow out of a[n - 1]. Safe when a == b.
+Digit SubInPlace(Digit* a, size_t n, const Digit* b, size_t m);
+
+// a[0, n) = b[0, n) - a[0, n) for b >= a; returns the borrow.
+Digit SubFromInPlace(Digit* a, const Digit* b, size_t n);
+
+// a[0, n) *= d; returns the carry digit.
+Digit MulDigitInPlace(Digit* a, size_t n, Digit d);
+
+// res[0, n) += a[0, n) * d and res[0, n) -= a[0, n) * d; return the carry or borrow digit.
+Digit AddMulDigit(Digit* res, const Digit* a, size_t n, Digit d);
+Digit SubMulDigit(Digit* res, const Digit* a, size_t n, Digit d);
+
+// res[0, n) = a[0, n) << shift for 0 <= shift < kDigitBits; returns the bits shifted out.
+// res may equal a.
+Digit ShiftLeft(Digit* res, const Digit* a, size_t n, int shift);
+
+// res[0, n) = a[0, n) >> shift for 0 <= shift < kDigitBits; returns the bits shifted out,
+// aligned to the top of the digit. res may equal a.
+Digit ShiftRight(Digit* res, const Digit* a, size_t n, int shift);
+
+// res[0, n + m) = a[0, n) * b[0, m).
+void MulSchoolbook(Digit* res, const Digit* a, size_t n, const Digit* b, size_t m);
+void MulKaratsuba(Digit* res, const Digit* a, size_t n, const Digit* b, size_t m);
+void MulToom3(Digit* res, const Digit* a, size_t n, const Digit* b, size_t m);
+
+// Exact three-prime number-theoretic transform; falls back to Toom-3 when n + m exceeds kMaxNttDigits.
+const size_t kMaxNttDigits = size_t{1} << 22;
+void MulNtt(Digit* res, const Digit* a, size_t n, const Digit* b, size_t m);
+
+// res[0, 2n) = a[0, n)^2, computing each cross product a[i] * a[j] once.
+void SqrSchoolbook(Digit* res, const Digit* a, size_t n);
+
+// Picks the algorithm from Thresholds() by the size of the shorter operand. Squares, with a == b
+// and n == m, keep to squaring all the way down to SqrSchoolbook.
+void Mul(Digit* res, const Digit* a, size_t n, const Digit* b, size_t m);
+
+// res[0, 2n) = a[0, n)^2; the same as Mul(res, a, n, a, n).
+void Sqr(Digit* res, const Digit* a, size_t n);
+
+// q[0, n) = a[0, n) / d; returns the remainder. q may equal a.
+Digit DivModDigit(Digit* q, const Digit* a, size_t n, Digit d);
+
+// q[0, n - m + 1) = a[0, n) / b[0, m) and r[0, m) = a % b, for n >= m >= 2 and b[m - 1] != 0.
+void DivModKnuth(Digit* q, Digit* r, const Digit* a, size_t n, const Digit* b, size_t m);
+
+// Same, working in caller scratch u[0, n + 1) and v[0, m) instead of allocating.
+void DivModKnuth(Digit* q, Digit* r, const Digit* a, size_t n, const Digit* b, size_t m, Digit* u, Digit* v);
+
+// Same contract as DivModKnuth; divides by multiplying with a Newton-iterated reciprocal.
+const size_t kNewtonDivisionThreshold = 500;
+void DivModNewton(Digit* q, Digit* r, const Digit* a, size_t n, const Digit* b, size_t m);
+
+// Same contract for n >= m >= 1; uses Newton division once both the divisor and the quotient
+// reach kNewtonDivisionThreshold digits.
+void DivMod(Digit* q, Digit* r, const Digit* a, size_t n, const Digit* b, size_t m);
+
+}  // namespace big_integer_kernels
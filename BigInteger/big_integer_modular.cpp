@@ -0,0 +1,470 @@
+#include "big_integer_modular.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+using big_integer_kernels::Digit;
+using big_integer_kernels::kDigitBits;
+
+size_t BitLength(const Digit* a, size_t n) {
+  n = big_integer_kernels::Normalized(a, n);
+  if (n == 0) {
+    return 0;
+  }
+
+  size_t bits = (n - 1) * kDigitBits;
+  for (Digit top = a[n - 1]; top != 0; top >>= 1) {
+    ++bits;
+  }
+  return bits;
+}
+
+bool BitAt(const Digit* a, size_t i) {
+  return (a[i / kDigitBits] >> (i % kDigitBits)) & 1;
+}
+
+// Window width minimising squarings plus table multiplications for an exponent of this length.
+size_t WindowBits(size_t bits) {
+  if (bits > 671) {
+    return 6;
+  }
+  if (bits > 239) {
+    return 5;
+  }
+  if (bits > 79) {
+    return 4;
+  }
+  if (bits > 23) {
+    return 3;
+  }
+  return bits > 4 ? 2 : 1;
+}
+
+// res[0, k) = base^e for residues of k digits, where mul(res, a, b) multiplies residues and
+// tolerates res aliasing a or b. Left-to-right sliding window over the odd powers of base.
+template <class MulFunction>
+void SlidingWindowPow(Digit* res, const Digit* base, const Digit* one, size_t k, const Digit* e, size_t ne,
+                      MulFunction mul) {
+  size_t bits = BitLength(e, ne);
+  if (bits == 0) {
+    std::copy(one, one + k, res);
+    return;
+  }
+
+  size_t window = WindowBits(bits);
+  size_t table_size = size_t{1} << (window - 1);
+
+  // table[i] = base^(2i + 1).
+  DigitBuffer table;
+  table.Resize(table_size * k);
+  std::copy(base, base + k, table.Data());
+  if (table_size > 1) {
+    DigitBuffer square;
+    square.Resize(k);
+    mul(square.Data(), base, base);
+    for (size_t i = 1; i < table_size; ++i) {
+      mul(table.Data() + i * k, table.Data() + (i - 1) * k, square.Data());
+    }
+  }
+
+  bool started = false;
+  for (size_t i = bits; i-- > 0;) {
+    if (!BitAt(e, i)) {
+      mul(res, res, res);
+      continue;
+    }
+
+    size_t low = i + 1 > window ? i + 1 - window : 0;
+    while (!BitAt(e, low)) {
+      ++low;
+    }
+
+    size_t value = 0;
+    for (size_t j = i + 1; j-- > low;) {
+      value = 2 * value + BitAt(e, j);
+    }
+
+    const Digit* power = table.Data() + (value >> 1) * k;
+    if (started) {
+      for (size_t j = low; j <= i; ++j) {
+        mul(res, res, res);
+      }
+      mul(res, res, power);
+    } else {
+      std::copy(power, power + k, res);
+      started = true;
+    }
+
+    i = low;
+  }
+}
+
+
+// Bits [start, start + 62) of x[0, n), with digits past n read as zero.
+int64_t LeadingBits(const Digit* x, size_t n, size_t start) {
+  auto digit = [&](size_t i) -> uint64_t {
+    return i < n ? x[i] : 0;
+  };
+
+  size_t i = start / kDigitBits;
+  int shift = static_cast<int>(start % kDigitBits);
+  uint64_t low = digit(i) | (digit(i + 1) << kDigitBits);
+  uint64_t bits = shift == 0 ? low : (low >> shift) | (digit(i + 2) << (2 * kDigitBits - shift));
+
+  return static_cast<int64_t>(bits & ((uint64_t{1} << 62) - 1));
+}
+
+// res[0, n + 1) = p * x - q * y for digit counts xn, yn <= n, when the result is known to be
+// non-negative.
+void CombineDigits(Digit* res, size_t n, const Digit* x, size_t xn, Digit p, const Digit* y, size_t yn, Digit q) {
+  std::fill(res, res + n + 1, 0);
+
+  Digit carry = big_integer_kernels::AddMulDigit(res, x, xn, p);
+  big_integer_kernels::AddInPlace(res + xn, n + 1 - xn, &carry, 1);
+  Digit borrow = big_integer_kernels::SubMulDigit(res, y, yn, q);
+  big_integer_kernels::SubInPlace(res + yn, n + 1 - yn, &borrow, 1);
+}
+
+void Trim(DigitBuffer& x) {
+  x.Resize(big_integer_kernels::Normalized(x.Data(), x.Size()));
+}
+
+// Reduces a >= b to (Gcd(a, b), 0), both normalized (zero is empty). With track set, every step
+// is reported: on_quotient(q) for a Euclid step (a, b) -> (b, a - q * b) and on_matrix(ca, cb,
+// cc, cd) for (a, b) -> (ca * a + cb * b, cc * a + cd * b), so callers can follow cofactors.
+template <class OnQuotient, class OnMatrix>
+void LehmerGcd(DigitBuffer& a, DigitBuffer& b, bool track, OnQuotient on_quotient, OnMatrix on_matrix) {
+  const int64_t kDigitRange = int64_t{1} << kDigitBits;
+  DigitBuffer scratch_a;
+  DigitBuffer scratch_b;
+
+  while (!b.Empty()) {
+    size_t n = a.Size();
+
+    if (!track && n <= 2) {
+      uint64_t x = a[0] | (n > 1 ? static_cast<uint64_t>(a[1]) << kDigitBits : 0);
+      uint64_t y = b[0] | (b.Size() > 1 ? static_cast<uint64_t>(b[1]) << kDigitBits : 0);
+      while (y != 0) {
+        x %= y;
+        std::swap(x, y);
+      }
+      a.Resize(2);
+      a[0] = static_cast<Digit>(x);
+      a[1] = static_cast<Digit>(x >> kDigitBits);
+      Trim(a);
+      b.Clear();
+      return;
+    }
+
+    // Knuth's Algorithm L on the leading bits. The quotient is accepted only when both ends of
+    // its uncertainty interval agree, and the loop stops while the cofactors still fit a digit.
+    int64_t ca = 1;
+    int64_t cb = 0;
+    int64_t cc = 0;
+    int64_t cd = 1;
+    if (n > 2) {
+      size_t start = BitLength(a.Data(), n) - 62;
+      int64_t x = LeadingBits(a.Data(), n, start);
+      int64_t y = LeadingBits(b.Data(), b.Size(), start);
+
+      while (y >= kDigitRange) {
+        int64_t q = (x + ca) / (y + cc);
+        if (q != (x + cb) / (y + cd)) {
+          break;
+        }
+
+        int64_t next_c = ca - q * cc;
+        int64_t next_d = cb - q * cd;
+        if (next_c <= -kDigitRange || next_c >= kDigitRange || next_d <= -kDigitRange || next_d >= kDigitRange) {
+          break;
+        }
+
+        ca = cc;
+        cb = cd;
+        cc = next_c;
+        cd = next_d;
+        int64_t next_y = x - q * y;
+        x = y;
+        y = next_y;
+      }
+    }
+
+    if (cb == 0) {
+      // No step could be simulated: one full Euclid step.
+      DigitBuffer quotient;
+      quotient.Resize(n - b.Size() + 1);
+      scratch_a.Resize(b.Size());
+      big_integer_kernels::DivMod(quotient.Data(), scratch_a.Data(), a.Data(), n, b.Data(), b.Size());
+      Trim(scratch_a);
+      std::swap(a, b);
+      std::swap(b, scratch_a);
+
+      if (track) {
+        on_quotient(std::move(quotient));
+      }
+      continue;
+    }
+
+    // Cofactor rows alternate in sign, so each new value is one product minus another.
+    scratch_a.Resize(n + 1);
+    scratch_b.Resize(n + 1);
+    auto combine = [&](Digit* res, int64_t p, int64_t q) {
+      if (q <= 0) {
+        CombineDigits(res, n, a.Data(), n, static_cast<Digit>(p), b.Data(), b.Size(), static_cast<Digit>(-q));
+      } else {
+        CombineDigits(res, n, b.Data(), b.Size(), static_cast<Digit>(q), a.Data(), n, static_cast<Digit>(-p));
+      }
+    };
+    combine(scratch_a.Data(), ca, cb);
+    combine(scratch_b.Data(), cc, cd);
+    Trim(scratch_a);
+    Trim(scratch_b);
+    std::swap(a, scratch_a);
+    std::swap(b, scratch_b);
+
+    if (track) {
+      on_matrix(ca, cb, cc, cd);
+    }
+  }
+}
+
+}  // namespace
+
+MontgomeryContext::MontgomeryContext(const BigInteger& modulus) : modulus_(Abs(modulus)) {
+  if (!modulus_) {
+    throw BigIntegerDivisionByZero{};
+  }
+  if (modulus_.digits_[0] % 2 == 0) {
+    throw std::invalid_argument("MontgomeryContext: even modulus");
+  }
+
+  size_ = modulus_.digits_.Size();
+
+  // Newton iteration for the inverse modulo 2^32: each step doubles the number of correct bits,
+  // and m * m = 1 mod 8 gives the first three.
+  Digit m0 = modulus_.digits_[0];
+  Digit inverse = m0;
+  for (int i = 0; i < 4; ++i) {
+    inverse *= 2 - m0 * inverse;
+  }
+  inverse_ = 0 - inverse;
+
+  // R^2 mod modulus by one division of 2^(64 * size_).
+  DigitBuffer power;
+  power.Resize(2 * size_ + 1);
+  power.Back() = 1;
+  DigitBuffer quotient;
+  quotient.Resize(size_ + 2);
+  r_squared_.Resize(size_);
+  big_integer_kernels::DivMod(quotient.Data(), r_squared_.Data(), power.Data(), power.Size(),
+                              modulus_.digits_.Data(), size_);
+
+  one_ = ToMontgomery(BigInteger(1));
+}
+
+const BigInteger& MontgomeryContext::Modulus() const {
+  return modulus_;
+}
+
+void MontgomeryContext::Multiply(Digit* res, const Digit* a, const Digit* b, Digit* scratch) const {
+  const Digit* m = modulus_.digits_.Data();
+  size_t k = size_;
+
+  scratch[2 * k] = 0;
+  big_integer_kernels::Mul(scratch, a, k, b, k);
+
+  // Word-by-word REDC: clear the low digit k times, each time adding a multiple of the modulus.
+  for (size_t i = 0; i < k; ++i) {
+    Digit carry = big_integer_kernels::AddMulDigit(scratch + i, m, k, scratch[i] * inverse_);
+    big_integer_kernels::AddInPlace(scratch + i + k, k + 1 - i, &carry, 1);
+  }
+
+  // The quotient by R is below 2 * modulus.
+  Digit* t = scratch + k;
+  if (t[k] != 0 || big_integer_kernels::Compare(t, k, m, k) >= 0) {
+    big_integer_kernels::SubInPlace(t, k + 1, m, k);
+  }
+  std::copy(t, t + k, res);
+}
+
+DigitBuffer MontgomeryContext::ToMontgomery(const BigInteger& x) const {
+  DigitBuffer residue;
+  residue.Resize(size_);
+
+  const DigitBuffer& digits = x.digits_;
+  if (big_integer_kernels::Compare(digits.Data(), digits.Size(), modulus_.digits_.Data(), size_) < 0) {
+    std::copy(digits.begin(), digits.end(), residue.Data());
+  } else {
+    DigitBuffer quotient;
+    quotient.Resize(digits.Size() - size_ + 1);
+    big_integer_kernels::DivMod(quotient.Data(), residue.Data(), digits.Data(), digits.Size(),
+                                modulus_.digits_.Data(), size_);
+  }
+
+  if (x.is_negative_ && big_integer_kernels::Normalized(residue.Data(), size_) != 0) {
+    big_integer_kernels::SubFromInPlace(residue.Data(), modulus_.digits_.Data(), size_);
+  }
+
+  DigitBuffer scratch;
+  scratch.Resize(2 * size_ + 1);
+  Multiply(residue.Data(), residue.Data(), r_squared_.Data(), scratch.Data());
+
+  return residue;
+}
+
+BigInteger MontgomeryContext::FromMontgomery(const Digit* a) const {
+  DigitBuffer unit;
+  unit.Resize(size_);
+  unit[0] = 1;
+
+  DigitBuffer scratch;
+  scratch.Resize(2 * size_ + 1);
+  DigitBuffer res;
+  res.Resize(size_);
+  Multiply(res.Data(), a, unit.Data(), scratch.Data());
+
+  return BigInteger::FromDigits(std::move(res), false);
+}
+
+BigInteger MontgomeryContext::MulMod(const BigInteger& a, const BigInteger& b) const {
+  DigitBuffer x = ToMontgomery(a);
+  DigitBuffer y = ToMontgomery(b);
+
+  DigitBuffer scratch;
+  scratch.Resize(2 * size_ + 1);
+  Multiply(x.Data(), x.Data(), y.Data(), scratch.Data());
+
+  return FromMontgomery(x.Data());
+}
+
+BigInteger MontgomeryContext::PowMod(const BigInteger& base, const BigInteger& exponent) const {
+  if (exponent.IsNegative()) {
+    return PowMod(ModInverse(base, modulus_), -exponent);
+  }
+
+  DigitBuffer x = ToMontgomery(base);
+  DigitBuffer res;
+  res.Resize(size_);
+  DigitBuffer scratch;
+  scratch.Resize(2 * size_ + 1);
+
+  SlidingWindowPow(res.Data(), x.Data(), one_.Data(), size_, exponent.digits_.Data(), exponent.digits_.Size(),
+                   [&](Digit* out, const Digit* a, const Digit* b) {
+                     Multiply(out, a, b, scratch.Data());
+                   });
+
+  return FromMontgomery(res.Data());
+}
+
+BigInteger PowMod(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus) {
+  if (!modulus) {
+    throw BigIntegerDivisionByZero{};
+  }
+  if (modulus.digits_[0] % 2 != 0) {
+    return MontgomeryContext(modulus).PowMod(base, exponent);
+  }
+  if (exponent.IsNegative()) {
+    return PowMod(ModInverse(base, modulus), -exponent, modulus);
+  }
+
+  const DigitBuffer& m = modulus.digits_;
+  size_t k = m.Size();
+
+  BigInteger reduced = DivMod(base, modulus).second;
+  if (reduced.IsNegative()) {
+    reduced += Abs(modulus);
+  }
+
+  DigitBuffer x;
+  x.Resize(k);
+  std::copy(reduced.digits_.begin(), reduced.digits_.end(), x.Data());
+  DigitBuffer one;
+  one.Resize(k);
+  one[0] = 1;
+
+  DigitBuffer product;
+  product.Resize(2 * k);
+  DigitBuffer quotient;
+  quotient.Resize(k + 1);
+  DigitBuffer res;
+  res.Resize(k);
+
+  SlidingWindowPow(res.Data(), x.Data(), one.Data(), k, exponent.digits_.Data(), exponent.digits_.Size(),
+                   [&](Digit* out, const Digit* a, const Digit* b) {
+                     big_integer_kernels::Mul(product.Data(), a, k, b, k);
+                     big_integer_kernels::DivMod(quotient.Data(), out, product.Data(), 2 * k, m.Data(), k);
+                   });
+
+  return BigInteger::FromDigits(std::move(res), false);
+}
+
+BigInteger Gcd(const BigInteger& a, const BigInteger& b) {
+  DigitBuffer x = a.digits_;
+  DigitBuffer y = b.digits_;
+  Trim(x);
+  Trim(y);
+  if (big_integer_kernels::Compare(x.Data(), x.Size(), y.Data(), y.Size()) < 0) {
+    std::swap(x, y);
+  }
+
+  LehmerGcd(x, y, false, [](DigitBuffer&&) {}, [](int64_t, int64_t, int64_t, int64_t) {});
+  return BigInteger::FromDigits(std::move(x), false);
+}
+
+ExtendedGcdResult ExtendedGcd(const BigInteger& a, const BigInteger& b) {
+  DigitBuffer x = a.digits_;
+  DigitBuffer y = b.digits_;
+  Trim(x);
+  Trim(y);
+  bool swapped = big_integer_kernels::Compare(x.Data(), x.Size(), y.Data(), y.Size()) < 0;
+  if (swapped) {
+    std::swap(x, y);
+  }
+
+  // u and v are the coefficients of the larger input |first| in the current pair.
+  BigInteger u = 1;
+  BigInteger v = 0;
+  LehmerGcd(
+      x, y, true,
+      [&](DigitBuffer&& quotient) {
+        u -= BigInteger::FromDigits(std::move(quotient), false) * v;
+        std::swap(u, v);
+      },
+      [&](int64_t ca, int64_t cb, int64_t cc, int64_t cd) {
+        BigInteger next_u = BigInteger(ca) * u + BigInteger(cb) * v;
+        v = BigInteger(cc) * u + BigInteger(cd) * v;
+        u = std::move(next_u);
+      });
+
+  ExtendedGcdResult res;
+  res.gcd = BigInteger::FromDigits(std::move(x), false);
+
+  const BigInteger& first = swapped ? b : a;
+  const BigInteger& second = swapped ? a : b;
+  BigInteger first_coefficient = first.IsNegative() ? -u : u;
+  BigInteger second_coefficient = second ? (res.gcd - first * first_coefficient) / second : BigInteger(0);
+
+  res.x = swapped ? second_coefficient : first_coefficient;
+  res.y = swapped ? first_coefficient : second_coefficient;
+  return res;
+}
+
+BigInteger ModInverse(const BigInteger& a, const BigInteger& modulus) {
+  if (!modulus) {
+    throw BigIntegerDivisionByZero{};
+  }
+
+  BigInteger m = Abs(modulus);
+  ExtendedGcdResult res = ExtendedGcd(a % m, m);
+  if (res.gcd != 1) {
+    throw BigIntegerNotInvertible{};
+  }
+
+  BigInteger x = res.x % m;
+  if (x.IsNegative()) {
+    x += m;
+  }
+  return x;
+}
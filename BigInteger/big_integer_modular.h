@@ -0,0 +1,65 @@
+#pragma once
+
+#include "big_integer.h"
+#include "digit_buffer.h"
+
+class BigIntegerNotInvertible : public std::runtime_error {
+ public:
+  BigIntegerNotInvertible() : std::runtime_error("BigIntegerNotInvertible") {
+  }
+};
+
+// Arithmetic modulo a fixed odd modulus, kept in Montgomery form so that reductions are
+// multiplications instead of divisions. Build one context per modulus and reuse it.
+class MontgomeryContext {
+ public:
+  // Uses |modulus|; throws BigIntegerDivisionByZero for zero and std::invalid_argument for an
+  // even modulus.
+  explicit MontgomeryContext(const BigInteger& modulus);
+
+  const BigInteger& Modulus() const;
+
+  // Results are in [0, Modulus()).
+  BigInteger MulMod(const BigInteger& a, const BigInteger& b) const;
+  // Sliding-window exponentiation; a negative exponent raises the inverse of base.
+  BigInteger PowMod(const BigInteger& base, const BigInteger& exponent) const;
+
+ private:
+  using Digit = big_integer_kernels::Digit;
+
+  BigInteger modulus_;
+  size_t size_;
+  // -modulus^-1 mod 2^32.
+  Digit inverse_;
+  // R^2 mod modulus for R = 2^(32 * size_), to move values into Montgomery form.
+  DigitBuffer r_squared_;
+  DigitBuffer one_;
+
+  // res[0, size_) = a * b / R mod modulus for a, b < modulus. scratch holds 2 * size_ + 1 digits;
+  // res may equal a or b.
+  void Multiply(Digit* res, const Digit* a, const Digit* b, Digit* scratch) const;
+  // |x| mod modulus as size_ digits, then in Montgomery form.
+  DigitBuffer ToMontgomery(const BigInteger& x) const;
+  BigInteger FromMontgomery(const Digit* a) const;
+};
+
+// base^exponent mod |modulus| in [0, |modulus|). Odd moduli go through a MontgomeryContext; even
+// ones reduce every product by division. A negative exponent raises ModInverse(base, modulus).
+BigInteger PowMod(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus);
+
+// Greatest common divisor, non-negative; Gcd(0, 0) == 0. Lehmer's algorithm: runs of Euclid
+// steps are simulated on the leading 62 bits and applied to the full numbers at once.
+BigInteger Gcd(const BigInteger& a, const BigInteger& b);
+
+struct ExtendedGcdResult {
+  BigInteger gcd;
+  BigInteger x;
+  BigInteger y;
+};
+
+// gcd == Gcd(a, b) == a * x + b * y.
+ExtendedGcdResult ExtendedGcd(const BigInteger& a, const BigInteger& b);
+
+// x in [0, |modulus|) with a * x == 1 mod modulus; throws BigIntegerNotInvertible when a and
+// modulus are not coprime.
+BigInteger ModInverse(const BigInteger& a, const BigInteger& modulus);
@@ -0,0 +1,93 @@
+#include "big_integer_power.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Roots of at most this many bits are iterated to from a power of two.
+const size_t kBaseCaseRootBits = 32;
+
+// value / x^k, without forming x^k when it could run past the size cap.
+BigInteger DivideByPower(const BigInteger& value, const BigInteger& x, uint64_t k) {
+  if (x.BitLength() * k <= value.BitLength()) {
+    return value / Pow(x, k);
+  }
+
+  BigInteger res = value;
+  for (uint64_t i = 0; i < k && res; ++i) {
+    res /= x;
+  }
+  return res;
+}
+
+// floor(value^(1/n)) for value > 0 and n >= 2.
+BigInteger Root(const BigInteger& value, uint64_t n) {
+  size_t bits = value.BitLength();
+  if (n >= bits) {
+    return 1;
+  }
+
+  // The root has at most root_bits bits. Start above it: from a power of two for short roots,
+  // otherwise from one more than the root of value with the low n * shift bits dropped, shifted
+  // back up, which already has the leading half of the bits right.
+  size_t root_bits = (bits + n - 1) / n;
+  BigInteger x;
+  if (root_bits <= kBaseCaseRootBits) {
+    x = BigInteger(1) << root_bits;
+  } else {
+    size_t shift = root_bits / 2;
+    x = (Root(value >> (n * shift), n) + 1) << shift;
+  }
+
+  // x' = ((n - 1) x + value / x^(n - 1)) / n decreases while x is above the root.
+  BigInteger n_minus_one(static_cast<int64_t>(n - 1));
+  BigInteger divisor(static_cast<int64_t>(n));
+  while (true) {
+    BigInteger next = (x * n_minus_one + DivideByPower(value, x, n - 1)) / divisor;
+    if (next >= x) {
+      return x;
+    }
+    x = std::move(next);
+  }
+}
+
+}  // namespace
+
+BigInteger Pow(const BigInteger& base, uint64_t exponent) {
+  if (exponent == 0) {
+    return 1;
+  }
+
+  uint64_t mask = uint64_t{1} << 63;
+  while ((exponent & mask) == 0) {
+    mask >>= 1;
+  }
+
+  BigInteger res = base;
+  for (mask >>= 1; mask != 0; mask >>= 1) {
+    res *= res;
+    if ((exponent & mask) != 0) {
+      res *= base;
+    }
+  }
+  return res;
+}
+
+BigInteger Sqrt(const BigInteger& value) {
+  return NthRoot(value, 2);
+}
+
+BigInteger NthRoot(const BigInteger& value, uint64_t n) {
+  if (n == 0) {
+    throw std::invalid_argument("NthRoot: zeroth root");
+  }
+  if (value.IsNegative() && n % 2 == 0) {
+    throw std::invalid_argument("NthRoot: even root of a negative value");
+  }
+  if (n == 1 || !value) {
+    return value;
+  }
+
+  return value.IsNegative() ? -Root(-value, n) : Root(value, n);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+#include "big_integer.h"
+
+// base^exponent by left-to-right square-and-multiply; the squarings go through the squaring
+// kernels. Pow(x, 0) is 1.
+BigInteger Pow(const BigInteger& base, uint64_t exponent);
+
+// The square root and the n-th root of value, truncated toward zero. Newton iteration from above,
+// started from the root of the leading digits, so that the iterations run at doubling precision
+// and the whole costs about as much as a few full-size divisions. Throw std::invalid_argument for
+// n == 0 and for even roots of negative values.
+BigInteger Sqrt(const BigInteger& value);
+BigInteger NthRoot(const BigInteger& value, uint64_t n);
@@ -0,0 +1,269 @@
+#include "big_integer_simd.h"
+
+#if !defined(BIG_INTEGER_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define BIG_INTEGER_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace big_integer_simd {
+
+namespace {
+
+using big_integer_kernels::DoubleDigit;
+using big_integer_kernels::kDigitBits;
+
+// Shorter spans go straight to the scalar loops.
+const size_t kMinVectorDigits = 8;
+
+Digit AddScalar(Digit* a, const Digit* b, size_t n, Digit carry) {
+  DoubleDigit c = carry;
+  for (size_t i = 0; i < n; ++i) {
+    DoubleDigit sum = static_cast<DoubleDigit>(a[i]) + b[i] + c;
+    a[i] = static_cast<Digit>(sum);
+    c = sum >> kDigitBits;
+  }
+  return static_cast<Digit>(c);
+}
+
+Digit SubScalar(Digit* a, const Digit* b, size_t n, Digit borrow) {
+  for (size_t i = 0; i < n; ++i) {
+    DoubleDigit diff = static_cast<DoubleDigit>(a[i]) - b[i] - borrow;
+    a[i] = static_cast<Digit>(diff);
+    borrow = static_cast<Digit>(diff >> kDigitBits) & 1;
+  }
+  return borrow;
+}
+
+size_t HighestDifferenceScalar(const Digit* a, const Digit* b, size_t n) {
+  while (n > 0 && a[n - 1] == b[n - 1]) {
+    --n;
+  }
+  return n;
+}
+
+#ifdef BIG_INTEGER_SIMD_X86
+
+// Lanes that take a carry or borrow, and the one leaving the block, for lane count kLanes.
+template <int kLanes>
+unsigned ResolveCarries(unsigned generate, unsigned propagate, unsigned& carry) {
+  unsigned sum = (generate << 1) + propagate + carry;
+  carry = sum >> kLanes;
+  return (sum ^ propagate) & ((1u << kLanes) - 1);
+}
+
+__attribute__((target("avx2"))) __m256i LaneMask256(unsigned bits) {
+  const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int>(bits)), lane_bits), lane_bits);
+}
+
+__attribute__((target("avx2"))) Digit AddAvx2(Digit* a, const Digit* b, size_t n, Digit carry) {
+  const __m256i sign = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+  const __m256i ones = _mm256_set1_epi32(-1);
+  unsigned c = carry;
+  size_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    __m256i sum = _mm256_add_epi32(x, y);
+    // Unsigned x > sum means the lane wrapped.
+    __m256i wrapped = _mm256_cmpgt_epi32(_mm256_xor_si256(x, sign), _mm256_xor_si256(sum, sign));
+    __m256i saturated = _mm256_cmpeq_epi32(sum, ones);
+
+    unsigned generate = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(wrapped)));
+    unsigned propagate = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(saturated)));
+    unsigned lanes = ResolveCarries<8>(generate, propagate, c);
+
+    sum = _mm256_sub_epi32(sum, LaneMask256(lanes));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), sum);
+  }
+
+  return AddScalar(a + i, b + i, n - i, c);
+}
+
+__attribute__((target("avx2"))) Digit SubAvx2(Digit* a, const Digit* b, size_t n, Digit borrow) {
+  const __m256i sign = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+  const __m256i zero = _mm256_setzero_si256();
+  unsigned c = borrow;
+  size_t i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    __m256i diff = _mm256_sub_epi32(x, y);
+    __m256i wrapped = _mm256_cmpgt_epi32(_mm256_xor_si256(y, sign), _mm256_xor_si256(x, sign));
+    __m256i empty = _mm256_cmpeq_epi32(diff, zero);
+
+    unsigned generate = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(wrapped)));
+    unsigned propagate = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(empty)));
+    unsigned lanes = ResolveCarries<8>(generate, propagate, c);
+
+    diff = _mm256_add_epi32(diff, LaneMask256(lanes));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), diff);
+  }
+
+  return SubScalar(a + i, b + i, n - i, c);
+}
+
+__attribute__((target("avx2"))) size_t HighestDifferenceAvx2(const Digit* a, const Digit* b, size_t n) {
+  for (; n >= 8; n -= 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + n - 8));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + n - 8));
+    unsigned equal = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, y))));
+    if (equal != 0xFF) {
+      return n - 8 + (kDigitBits - __builtin_clz(~equal & 0xFF));
+    }
+  }
+  return HighestDifferenceScalar(a, b, n);
+}
+
+__attribute__((target("sse2"))) __m128i LaneMask128(unsigned bits) {
+  const __m128i lane_bits = _mm_setr_epi32(1, 2, 4, 8);
+  return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(static_cast<int>(bits)), lane_bits), lane_bits);
+}
+
+__attribute__((target("sse2"))) Digit AddSse2(Digit* a, const Digit* b, size_t n, Digit carry) {
+  const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+  const __m128i ones = _mm_set1_epi32(-1);
+  unsigned c = carry;
+  size_t i = 0;
+
+  for (; i + 4 <= n; i += 4) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    __m128i sum = _mm_add_epi32(x, y);
+    __m128i wrapped = _mm_cmpgt_epi32(_mm_xor_si128(x, sign), _mm_xor_si128(sum, sign));
+    __m128i saturated = _mm_cmpeq_epi32(sum, ones);
+
+    unsigned generate = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(wrapped)));
+    unsigned propagate = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(saturated)));
+    unsigned lanes = ResolveCarries<4>(generate, propagate, c);
+
+    sum = _mm_sub_epi32(sum, LaneMask128(lanes));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), sum);
+  }
+
+  return AddScalar(a + i, b + i, n - i, c);
+}
+
+__attribute__((target("sse2"))) Digit SubSse2(Digit* a, const Digit* b, size_t n, Digit borrow) {
+  const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+  const __m128i zero = _mm_setzero_si128();
+  unsigned c = borrow;
+  size_t i = 0;
+
+  for (; i + 4 <= n; i += 4) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    __m128i diff = _mm_sub_epi32(x, y);
+    __m128i wrapped = _mm_cmpgt_epi32(_mm_xor_si128(y, sign), _mm_xor_si128(x, sign));
+    __m128i empty = _mm_cmpeq_epi32(diff, zero);
+
+    unsigned generate = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(wrapped)));
+    unsigned propagate = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(empty)));
+    unsigned lanes = ResolveCarries<4>(generate, propagate, c);
+
+    diff = _mm_add_epi32(diff, LaneMask128(lanes));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), diff);
+  }
+
+  return SubScalar(a + i, b + i, n - i, c);
+}
+
+__attribute__((target("sse2"))) size_t HighestDifferenceSse2(const Digit* a, const Digit* b, size_t n) {
+  for (; n >= 4; n -= 4) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + n - 4));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + n - 4));
+    unsigned equal = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, y))));
+    if (equal != 0xF) {
+      return n - 4 + (kDigitBits - __builtin_clz(~equal & 0xF));
+    }
+  }
+  return HighestDifferenceScalar(a, b, n);
+}
+
+#endif  // BIG_INTEGER_SIMD_X86
+
+Level DetectLevel() {
+#ifdef BIG_INTEGER_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Level::kAvx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return Level::kSse2;
+  }
+#endif
+  return Level::kScalar;
+}
+
+Level& Active() {
+  static Level level = Detected();
+  return level;
+}
+
+}  // namespace
+
+Level Detected() {
+  static const Level level = DetectLevel();
+  return level;
+}
+
+Level ActiveLevel() {
+  return Active();
+}
+
+void SetActiveLevel(Level level) {
+  Active() = level <= Detected() ? level : Detected();
+}
+
+Digit AddDigits(Digit* a, const Digit* b, size_t n, Digit carry) {
+#ifdef BIG_INTEGER_SIMD_X86
+  if (n >= kMinVectorDigits) {
+    switch (Active()) {
+      case Level::kAvx2:
+        return AddAvx2(a, b, n, carry);
+      case Level::kSse2:
+        return AddSse2(a, b, n, carry);
+      case Level::kScalar:
+        break;
+    }
+  }
+#endif
+  return AddScalar(a, b, n, carry);
+}
+
+Digit SubDigits(Digit* a, const Digit* b, size_t n, Digit borrow) {
+#ifdef BIG_INTEGER_SIMD_X86
+  if (n >= kMinVectorDigits) {
+    switch (Active()) {
+      case Level::kAvx2:
+        return SubAvx2(a, b, n, borrow);
+      case Level::kSse2:
+        return SubSse2(a, b, n, borrow);
+      case Level::kScalar:
+        break;
+    }
+  }
+#endif
+  return SubScalar(a, b, n, borrow);
+}
+
+size_t HighestDifference(const Digit* a, const Digit* b, size_t n) {
+#ifdef BIG_INTEGER_SIMD_X86
+  if (n >= kMinVectorDigits) {
+    switch (Active()) {
+      case Level::kAvx2:
+        return HighestDifferenceAvx2(a, b, n);
+      case Level::kSse2:
+        return HighestDifferenceSse2(a, b, n);
+      case Level::kScalar:
+        break;
+    }
+  }
+#endif
+  return HighestDifferenceScalar(a, b, n);
+}
+
+}  // namespace big_integer_simd
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+
+#include "big_integer_kernels.h"
+
+// Vectorised carry, borrow and compare loops behind big_integer_kernels, chosen at run time from
+// what the CPU supports. Carries between lanes are resolved with one scalar addition on the
+// lane masks: with g the lanes that overflow and p the lanes that pass a carry on (all ones
+// after an addition, zero after a subtraction), the lanes receiving a carry are
+// ((g << 1) + p + carry_in) ^ p and the carry out is the bit above the last lane.
+//
+// Define BIG_INTEGER_NO_SIMD to build only the scalar loops.
+namespace big_integer_simd {
+
+using big_integer_kernels::Digit;
+
+enum class Level { kScalar, kSse2, kAvx2 };
+
+// Best level the CPU supports.
+Level Detected();
+
+// Level in use, Detected() unless lowered, e.g. to compare against the scalar loops. Not
+// synchronised.
+Level ActiveLevel();
+void SetActiveLevel(Level level);
+
+// a[0, n) += b[0, n) plus carry, which is 0 or 1; returns the carry out. Safe when a == b.
+Digit AddDigits(Digit* a, const Digit* b, size_t n, Digit carry);
+
+// a[0, n) -= b[0, n) plus borrow, which is 0 or 1; returns the borrow out. Safe when a == b.
+Digit SubDigits(Digit* a, const Digit* b, size_t n, Digit borrow);
+
+// One past the highest index where a[0, n) and b[0, n) differ, or 0 when they are equal.
+size_t HighestDifference(const Digit* a, const Digit* b, size_t n);
+
+}  // namespace big_integer_simd
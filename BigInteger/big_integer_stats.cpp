@@ -0,0 +1,119 @@
+#include "big_integer_stats.h"
+
+#include <atomic>
+#include <iomanip>
+#include <ostream>
+
+namespace big_integer_stats {
+
+namespace {
+
+struct Counters {
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> nanoseconds{0};
+  std::array<std::atomic<uint64_t>, kSizeBuckets> sizes{};
+};
+
+std::array<Counters, kOperationCount> counters;
+std::atomic<uint64_t> allocations{0};
+std::atomic<uint64_t> reallocations{0};
+std::atomic<uint64_t> copied{0};
+
+const char* const kNames[] = {
+    "add", "sub", "mul", "sqr", "divmod", "shift", "bitwise", "parse", "print",
+    "mul_schoolbook", "sqr_schoolbook", "mul_karatsuba", "mul_toom3", "mul_ntt", "mul_unbalanced",
+    "divmod_digit", "divmod_knuth", "divmod_newton",
+};
+static_assert(sizeof(kNames) / sizeof(kNames[0]) == kOperationCount, "a name for every operation");
+
+size_t Bucket(size_t digits) {
+  size_t bucket = 0;
+  while (digits > 1 && bucket + 1 < kSizeBuckets) {
+    digits >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+}  // namespace
+
+const char* Name(Operation operation) {
+  return kNames[static_cast<size_t>(operation)];
+}
+
+Stats Snapshot() {
+  Stats stats;
+  for (size_t i = 0; i < kOperationCount; ++i) {
+    stats.operations[i].calls = counters[i].calls.load(std::memory_order_relaxed);
+    stats.operations[i].nanoseconds = counters[i].nanoseconds.load(std::memory_order_relaxed);
+    for (size_t b = 0; b < kSizeBuckets; ++b) {
+      stats.operations[i].sizes[b] = counters[i].sizes[b].load(std::memory_order_relaxed);
+    }
+  }
+  stats.allocations = allocations.load(std::memory_order_relaxed);
+  stats.reallocations = reallocations.load(std::memory_order_relaxed);
+  stats.copied_digits = copied.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void Reset() {
+  for (Counters& counter : counters) {
+    counter.calls.store(0, std::memory_order_relaxed);
+    counter.nanoseconds.store(0, std::memory_order_relaxed);
+    for (std::atomic<uint64_t>& size : counter.sizes) {
+      size.store(0, std::memory_order_relaxed);
+    }
+  }
+  allocations.store(0, std::memory_order_relaxed);
+  reallocations.store(0, std::memory_order_relaxed);
+  copied.store(0, std::memory_order_relaxed);
+}
+
+void Dump(std::ostream& os) {
+  if (!kEnabled) {
+    os << "BigInteger stats are disabled; build with BIG_INTEGER_STATS to record them\n";
+    return;
+  }
+
+  Stats stats = Snapshot();
+  std::ios_base::fmtflags flags = os.flags();
+
+  os << std::left << std::setw(16) << "operation" << std::right << std::setw(12) << "calls" << std::setw(14)
+     << "total ms" << std::setw(12) << "ns/call" << "  calls by digits\n";
+  for (size_t i = 0; i < kOperationCount; ++i) {
+    const OperationStats& op = stats.operations[i];
+    if (op.calls == 0) {
+      continue;
+    }
+    os << std::left << std::setw(16) << kNames[i] << std::right << std::setw(12) << op.calls << std::setw(14)
+       << std::fixed << std::setprecision(3) << static_cast<double>(op.nanoseconds) / 1e6 << std::setw(12)
+       << op.nanoseconds / op.calls << " ";
+    for (size_t b = 0; b < kSizeBuckets; ++b) {
+      if (op.sizes[b] != 0) {
+        os << " " << (uint64_t{1} << b) << (b + 1 < kSizeBuckets ? "" : "+") << ":" << op.sizes[b];
+      }
+    }
+    os << "\n";
+  }
+  os << "digit allocations " << stats.allocations << ", reallocations " << stats.reallocations << " ("
+     << stats.copied_digits << " digits copied)\n";
+
+  os.flags(flags);
+}
+
+void Record(Operation operation, size_t digits, uint64_t nanoseconds) {
+  Counters& counter = counters[static_cast<size_t>(operation)];
+  counter.calls.fetch_add(1, std::memory_order_relaxed);
+  counter.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+  counter.sizes[Bucket(digits)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void RecordAllocation(size_t copied_digits) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (copied_digits != 0) {
+    reallocations.fetch_add(1, std::memory_order_relaxed);
+    copied.fetch_add(copied_digits, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace big_integer_stats
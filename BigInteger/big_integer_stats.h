@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Call counts, operand sizes and time per BigInteger operation and per kernel algorithm, plus
+// digit buffer allocations, for tuning the multiplication thresholds on real traffic. Recording
+// is compiled in only when BIG_INTEGER_STATS is defined (the CMake option of the same name);
+// otherwise the hooks expand to nothing and Snapshot() stays all zeros.
+//
+// Counters are shared by all threads and updated with relaxed atomics. Kernel entries nest: the
+// time of mul includes that of the algorithms it dispatches to, and Karatsuba and Toom-3 count
+// each recursive product again.
+namespace big_integer_stats {
+
+enum class Operation {
+  // BigInteger operators, sized by the longer operand; mul by the shorter factor and divmod by
+  // the divisor, which is what the kernel choice depends on.
+  kAdd,
+  kSub,
+  kMul,
+  kSqr,
+  kDivMod,
+  kShift,
+  kBitwise,
+  kParse,
+  kPrint,
+  // Algorithms chosen by big_integer_kernels::Mul and DivMod, sized the same way.
+  kMulSchoolbook,
+  kSqrSchoolbook,
+  kMulKaratsuba,
+  kMulToom3,
+  kMulNtt,
+  kMulUnbalanced,
+  kDivModDigit,
+  kDivModKnuth,
+  kDivModNewton,
+  kCount,
+};
+
+const size_t kOperationCount = static_cast<size_t>(Operation::kCount);
+
+// sizes[b] counts calls on operands of [2^b, 2^(b + 1)) digits; the last bucket takes the rest.
+const size_t kSizeBuckets = 24;
+
+struct OperationStats {
+  uint64_t calls = 0;
+  uint64_t nanoseconds = 0;
+  std::array<uint64_t, kSizeBuckets> sizes{};
+};
+
+struct Stats {
+  std::array<OperationStats, kOperationCount> operations;
+  // Heap blocks taken by digit buffers, and the growths among them that copied live digits.
+  uint64_t allocations = 0;
+  uint64_t reallocations = 0;
+  uint64_t copied_digits = 0;
+
+  const OperationStats& operator[](Operation operation) const {
+    return operations[static_cast<size_t>(operation)];
+  }
+};
+
+#ifdef BIG_INTEGER_STATS
+const bool kEnabled = true;
+#else
+const bool kEnabled = false;
+#endif
+
+const char* Name(Operation operation);
+
+Stats Snapshot();
+void Reset();
+
+// Prints the operations that were called, with their size histograms, and the allocation counts.
+void Dump(std::ostream& os);
+
+void Record(Operation operation, size_t digits, uint64_t nanoseconds);
+void RecordAllocation(size_t copied_digits);
+
+// Records one call of operation, timed from construction to destruction.
+class ScopedOperation {
+ public:
+  ScopedOperation(Operation operation, size_t digits)
+      : operation_(operation), digits_(digits), start_(std::chrono::steady_clock::now()) {
+  }
+  ScopedOperation(const ScopedOperation&) = delete;
+  ScopedOperation& operator=(const ScopedOperation&) = delete;
+
+  ~ScopedOperation() {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    Record(operation_, digits_,
+           static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+  }
+
+ private:
+  Operation operation_;
+  size_t digits_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace big_integer_stats
+
+#ifdef BIG_INTEGER_STATS
+#define BIG_INTEGER_STATS_OPERATION(operation, digits) \
+  ::big_integer_stats::ScopedOperation big_integer_stats_operation((operation), (digits))
+#define BIG_INTEGER_STATS_ALLOCATION(copied_digits) ::big_integer_stats::RecordAllocation(copied_digits)
+#else
+#define BIG_INTEGER_STATS_OPERATION(operation, digits) static_cast<void>(0)
+#define BIG_INTEGER_STATS_ALLOCATION(copied_digits) static_cast<void>(0)
+#endif
@@ -0,0 +1,86 @@
+#include "digit_allocator.h"
+
+#include <algorithm>
+
+namespace {
+
+thread_local DigitAllocator* current_allocator = nullptr;
+
+const size_t kArenaAlignment = alignof(std::max_align_t);
+
+size_t AlignUp(size_t bytes) {
+  return (bytes + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment;
+}
+
+}  // namespace
+
+DigitAllocator* CurrentDigitAllocator() {
+  return current_allocator;
+}
+
+ScopedDigitAllocator::ScopedDigitAllocator(DigitAllocator& allocator) : ScopedDigitAllocator(&allocator) {
+}
+
+ScopedDigitAllocator::ScopedDigitAllocator(DigitAllocator* allocator) : previous_(current_allocator) {
+  current_allocator = allocator;
+}
+
+ScopedDigitAllocator::~ScopedDigitAllocator() {
+  current_allocator = previous_;
+}
+
+DigitArena::DigitArena(size_t block_bytes) : current_(0), offset_(0), next_block_bytes_(AlignUp(block_bytes)) {
+}
+
+DigitArena::~DigitArena() {
+  for (const Block& block : blocks_) {
+    ::operator delete(block.data);
+  }
+}
+
+void* DigitArena::Allocate(size_t bytes) {
+  bytes = AlignUp(std::max<size_t>(bytes, 1));
+
+  // Move on through the blocks kept from before the last Reset, then grow geometrically.
+  while (current_ < blocks_.size() && blocks_[current_].size - offset_ < bytes) {
+    ++current_;
+    offset_ = 0;
+  }
+
+  if (current_ == blocks_.size()) {
+    size_t size = std::max(next_block_bytes_, bytes);
+    blocks_.push_back({static_cast<char*>(::operator new(size)), size});
+    next_block_bytes_ = 2 * size;
+    offset_ = 0;
+  }
+
+  void* res = blocks_[current_].data + offset_;
+  offset_ += bytes;
+  return res;
+}
+
+void DigitArena::Deallocate(void* block, size_t bytes) {
+  // Only the latest allocation can be given back, which covers the scratch of nested calls. A
+  // block freed by a thread the arena is not installed on, e.g. a pool worker, is left alone.
+  if (current_allocator != this) {
+    return;
+  }
+
+  bytes = AlignUp(std::max<size_t>(bytes, 1));
+  if (current_ < blocks_.size() && offset_ >= bytes && blocks_[current_].data + offset_ - bytes == block) {
+    offset_ -= bytes;
+  }
+}
+
+void DigitArena::Reset() {
+  current_ = 0;
+  offset_ = 0;
+}
+
+size_t DigitArena::Capacity() const {
+  size_t total = 0;
+  for (const Block& block : blocks_) {
+    total += block.size;
+  }
+  return total;
+}
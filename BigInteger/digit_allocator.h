@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// Where BigInteger digit storage and the scratch of the arithmetic kernels come from. By
+// default that is the global heap; a ScopedDigitAllocator redirects every allocation the
+// current thread makes to another source, such as a DigitArena reset between batches.
+class DigitAllocator {
+ public:
+  virtual ~DigitAllocator() = default;
+
+  // Blocks must be aligned for any fundamental type.
+  virtual void* Allocate(size_t bytes) = 0;
+  virtual void Deallocate(void* block, size_t bytes) = 0;
+};
+
+// The allocator installed on this thread, or nullptr for the global heap.
+DigitAllocator* CurrentDigitAllocator();
+
+// Installs allocator on the calling thread for the lifetime of the object. Blocks remember
+// their source and always go back to it, so values may be freed after the scope ends; with a
+// DigitArena they must not outlive its next Reset. Other threads, including the multiplication
+// thread pool, keep their own setting. A null allocator selects the global heap, for storage that
+// outlives the caller's scope, such as process-wide caches.
+class ScopedDigitAllocator {
+ public:
+  explicit ScopedDigitAllocator(DigitAllocator& allocator);
+  explicit ScopedDigitAllocator(DigitAllocator* allocator);
+  ScopedDigitAllocator(const ScopedDigitAllocator&) = delete;
+  ScopedDigitAllocator& operator=(const ScopedDigitAllocator&) = delete;
+  ~ScopedDigitAllocator();
+
+ private:
+  DigitAllocator* previous_;
+};
+
+// Monotonic bump allocator: frees are no-ops except for the most recent block, and Reset makes
+// all memory reusable at once while keeping it reserved. Not thread-safe; use one per thread.
+class DigitArena : public DigitAllocator {
+ public:
+  explicit DigitArena(size_t block_bytes = size_t{1} << 16);
+  DigitArena(const DigitArena&) = delete;
+  DigitArena& operator=(const DigitArena&) = delete;
+  ~DigitArena() override;
+
+  void* Allocate(size_t bytes) override;
+  void Deallocate(void* block, size_t bytes) override;
+
+  // Invalidates everything allocated so far.
+  void Reset();
+
+  // Bytes reserved from the global heap.
+  size_t Capacity() const;
+
+ private:
+  struct Block {
+    char* data;
+    size_t size;
+  };
+
+  std::vector<Block> blocks_;
+  size_t current_;
+  size_t offset_;
+  size_t next_block_bytes_;
+};
+
+// Standard allocator over CurrentDigitAllocator() for the kernels' scratch vectors. The source
+// is fixed when the container is created and moves with its storage.
+template <class T>
+class ScratchAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  ScratchAllocator() : source_(CurrentDigitAllocator()) {
+  }
+
+  template <class U>
+  ScratchAllocator(const ScratchAllocator<U>& other) : source_(other.Source()) {  // NOLINT
+  }
+
+  T* allocate(size_t n) {  // NOLINT
+    size_t bytes = n * sizeof(T);
+    return static_cast<T*>(source_ != nullptr ? source_->Allocate(bytes) : ::operator new(bytes));
+  }
+
+  void deallocate(T* p, size_t n) {  // NOLINT
+    if (source_ != nullptr) {
+      source_->Deallocate(p, n * sizeof(T));
+    } else {
+      ::operator delete(p);
+    }
+  }
+
+  // Copies take the allocator of the thread that makes them, so a copy made on a worker thread
+  // never touches another thread's arena.
+  ScratchAllocator select_on_container_copy_construction() const {  // NOLINT
+    return ScratchAllocator();
+  }
+
+  DigitAllocator* Source() const {
+    return source_;
+  }
+
+  template <class U>
+  friend bool operator==(const ScratchAllocator& a, const ScratchAllocator<U>& b) {
+    return a.source_ == b.Source();
+  }
+
+  template <class U>
+  friend bool operator!=(const ScratchAllocator& a, const ScratchAllocator<U>& b) {
+    return !(a == b);
+  }
+
+ private:
+  DigitAllocator* source_;
+};
+
+template <class T>
+using ScratchVector = std::vector<T, ScratchAllocator<T>>;
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include "big_integer_kernels.h"
+#include "big_integer_stats.h"
+#include "digit_allocator.h"
+
+// Digit storage of BigInteger. Values of up to kInlineCapacity digits (two 64-bit words) are
+// kept inside the object; longer ones spill to the heap, and the heap block is kept on shrink.
+// Heap blocks come from CurrentDigitAllocator() and start with a pointer to it, so they are
+// returned to their source whichever allocator is current when they are freed.
+class DigitBuffer {
+ public:
+  using Digit = big_integer_kernels::Digit;
+  static const size_t kInlineCapacity = 4;
+
+  DigitBuffer() : size_(0), capacity_(kInlineCapacity) {
+  }
+
+  DigitBuffer(const DigitBuffer& other) : DigitBuffer() {
+    Reserve(other.size_);
+    std::copy(other.begin(), other.end(), Data());
+    size_ = other.size_;
+  }
+
+  DigitBuffer(DigitBuffer&& other) noexcept : DigitBuffer() {
+    Steal(other);
+  }
+
+  DigitBuffer& operator=(const DigitBuffer& other) {
+    if (this != &other) {
+      size_ = 0;
+      Reserve(other.size_);
+      std::copy(other.begin(), other.end(), Data());
+      size_ = other.size_;
+    }
+    return *this;
+  }
+
+  DigitBuffer& operator=(DigitBuffer&& other) noexcept {
+    if (this != &other) {
+      Release();
+      Steal(other);
+    }
+    return *this;
+  }
+
+  ~DigitBuffer() {
+    Release();
+  }
+
+  size_t Size() const {
+    return size_;
+  }
+
+  size_t Capacity() const {
+    return capacity_;
+  }
+
+  bool Empty() const {
+    return size_ == 0;
+  }
+
+  Digit* Data() {
+    return IsInline() ? inline_ : heap_;
+  }
+
+  const Digit* Data() const {
+    return IsInline() ? inline_ : heap_;
+  }
+
+  Digit* begin() {  // NOLINT
+    return Data();
+  }
+
+  const Digit* begin() const {  // NOLINT
+    return Data();
+  }
+
+  Digit* end() {  // NOLINT
+    return Data() + size_;
+  }
+
+  const Digit* end() const {  // NOLINT
+    return Data() + size_;
+  }
+
+  Digit& operator[](size_t i) {
+    return Data()[i];
+  }
+
+  const Digit& operator[](size_t i) const {
+    return Data()[i];
+  }
+
+  Digit& Back() {
+    return Data()[size_ - 1];
+  }
+
+  const Digit& Back() const {
+    return Data()[size_ - 1];
+  }
+
+  void Reserve(size_t new_capacity) {
+    if (new_capacity <= capacity_) {
+      return;
+    }
+
+    BIG_INTEGER_STATS_ALLOCATION(size_);
+    Digit* new_data = Allocate(new_capacity);
+    std::copy(begin(), end(), new_data);
+    Release();
+    heap_ = new_data;
+    capacity_ = new_capacity;
+  }
+
+  void Resize(size_t new_size, Digit value = 0) {
+    Reserve(new_size);
+    if (new_size > size_) {
+      std::fill(Data() + size_, Data() + new_size, value);
+    }
+    size_ = new_size;
+  }
+
+  void PushBack(Digit value) {
+    if (size_ == capacity_) {
+      Reserve(2 * capacity_);
+    }
+    Data()[size_++] = value;
+  }
+
+  void PopBack() {
+    --size_;
+  }
+
+  void Clear() {
+    size_ = 0;
+  }
+
+  friend bool operator==(const DigitBuffer& a, const DigitBuffer& b) {
+    return a.size_ == b.size_ && std::equal(a.begin(), a.end(), b.begin());
+  }
+
+  friend bool operator!=(const DigitBuffer& a, const DigitBuffer& b) {
+    return !(a == b);
+  }
+
+ private:
+  size_t size_;
+  size_t capacity_;
+  union {
+    Digit inline_[kInlineCapacity];
+    Digit* heap_;
+  };
+
+  static const size_t kHeaderBytes = sizeof(DigitAllocator*);
+
+  bool IsInline() const {
+    return capacity_ == kInlineCapacity;
+  }
+
+  static Digit* Allocate(size_t capacity) {
+    DigitAllocator* source = CurrentDigitAllocator();
+    size_t bytes = kHeaderBytes + capacity * sizeof(Digit);
+    char* block = static_cast<char*>(source != nullptr ? source->Allocate(bytes) : ::operator new(bytes));
+    *reinterpret_cast<DigitAllocator**>(block) = source;
+    return reinterpret_cast<Digit*>(block + kHeaderBytes);
+  }
+
+  void Release() {
+    if (!IsInline()) {
+      char* block = reinterpret_cast<char*>(heap_) - kHeaderBytes;
+      DigitAllocator* source = *reinterpret_cast<DigitAllocator**>(block);
+      if (source != nullptr) {
+        source->Deallocate(block, kHeaderBytes + capacity_ * sizeof(Digit));
+      } else {
+        ::operator delete(block);
+      }
+      capacity_ = kInlineCapacity;
+    }
+  }
+
+  // Moves the contents of other into this buffer, which must be empty and inline, and leaves
+  // other empty and inline.
+  void Steal(DigitBuffer& other) {
+    if (other.IsInline()) {
+      std::copy(other.begin(), other.end(), inline_);
+    } else {
+      heap_ = other.heap_;
+      capacity_ = other.capacity_;
+      other.capacity_ = kInlineCapacity;
+    }
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+};
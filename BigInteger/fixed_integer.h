@@ -0,0 +1,516 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "big_integer.h"
+
+// Signed integer of magnitude below 2^Bits with its digits inside the object. It has the operator
+// surface of BigInteger, so code can switch between the two with a type alias. Like BigInteger,
+// it throws BigIntegerOverflow when a result does not fit, and the bitwise operators act on two's
+// complements. Addition, subtraction, multiplication, comparison, the bitwise operators and shifts
+// are constexpr and loop over a compile-time digit count. Division runs the BigInteger long
+// division kernel at run time on scratch inside the stack frame, so it does not allocate either;
+// text conversion goes through BigInteger.
+template <size_t Bits>
+class FixedInteger {
+  static_assert(Bits > 0, "FixedInteger needs at least one bit");
+
+ private:
+  using Digit = big_integer_kernels::Digit;
+  using DoubleDigit = big_integer_kernels::DoubleDigit;
+  static const int kDigitBits = big_integer_kernels::kDigitBits;
+  static constexpr size_t kDigits = (Bits + kDigitBits - 1) / kDigitBits;
+
+  Digit digits_[kDigits];
+  bool is_negative_;
+
+  // Digits up to the highest nonzero one.
+  constexpr size_t Length() const {
+    size_t n = kDigits;
+    while (n > 0 && digits_[n - 1] == 0) {
+      --n;
+    }
+    return n;
+  }
+
+  constexpr bool IsZero() const {
+    return Length() == 0;
+  }
+
+  constexpr void CheckOverflow() const {
+    if (BitLength() > Bits) {
+      throw BigIntegerOverflow{};
+    }
+  }
+
+  static constexpr int CompareMagnitude(const FixedInteger& a, const FixedInteger& b) {
+    for (size_t i = kDigits; i-- > 0;) {
+      if (a.digits_[i] != b.digits_[i]) {
+        return a.digits_[i] < b.digits_[i] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  // |*this| += |other|, |*this| -= |other| for |*this| >= |other|, and |*this| = |other| - |*this|
+  // for |*this| <= |other|.
+  constexpr void AddMagnitude(const FixedInteger& other) {
+    DoubleDigit carry = 0;
+    for (size_t i = 0; i < kDigits; ++i) {
+      DoubleDigit sum = static_cast<DoubleDigit>(digits_[i]) + other.digits_[i] + carry;
+      digits_[i] = static_cast<Digit>(sum);
+      carry = sum >> kDigitBits;
+    }
+    if (carry != 0) {
+      throw BigIntegerOverflow{};
+    }
+  }
+
+  constexpr void SubtractMagnitude(const FixedInteger& other) {
+    Digit borrow = 0;
+    for (size_t i = 0; i < kDigits; ++i) {
+      DoubleDigit diff = static_cast<DoubleDigit>(digits_[i]) - other.digits_[i] - borrow;
+      digits_[i] = static_cast<Digit>(diff);
+      borrow = static_cast<Digit>(diff >> kDigitBits) & 1;
+    }
+  }
+
+  constexpr void SubtractFromMagnitude(const FixedInteger& other) {
+    Digit borrow = 0;
+    for (size_t i = 0; i < kDigits; ++i) {
+      DoubleDigit diff = static_cast<DoubleDigit>(other.digits_[i]) - digits_[i] - borrow;
+      digits_[i] = static_cast<Digit>(diff);
+      borrow = static_cast<Digit>(diff >> kDigitBits) & 1;
+    }
+  }
+
+  // Two's complement of the value in kDigits + 1 digits, the top one holding the sign, and back.
+  constexpr void ToTwosComplement(Digit* out) const {
+    Digit carry = is_negative_ ? 1 : 0;
+    for (size_t i = 0; i < kDigits; ++i) {
+      out[i] = is_negative_ ? ~digits_[i] + carry : digits_[i];
+      carry &= out[i] == 0;
+    }
+    out[kDigits] = is_negative_ ? ~Digit{0} + carry : 0;
+  }
+
+  static constexpr FixedInteger FromTwosComplement(Digit* in) {
+    FixedInteger res;
+    res.is_negative_ = (in[kDigits] >> (kDigitBits - 1)) != 0;
+    Digit carry = 1;
+    for (size_t i = 0; i <= kDigits; ++i) {
+      if (res.is_negative_) {
+        in[i] = ~in[i] + carry;
+        carry &= in[i] == 0;
+      }
+    }
+    if (in[kDigits] != 0) {
+      throw BigIntegerOverflow{};
+    }
+    for (size_t i = 0; i < kDigits; ++i) {
+      res.digits_[i] = in[i];
+    }
+    res.CheckOverflow();
+    return res;
+  }
+
+  template <class Op>
+  static constexpr FixedInteger Bitwise(const FixedInteger& a, const FixedInteger& b, Op op) {
+    Digit x[kDigits + 1] = {};
+    Digit y[kDigits + 1] = {};
+    a.ToTwosComplement(x);
+    b.ToTwosComplement(y);
+    for (size_t i = 0; i <= kDigits; ++i) {
+      x[i] = op(x[i], y[i]);
+    }
+    return FromTwosComplement(x);
+  }
+
+  template <size_t OtherBits>
+  friend class FixedInteger;
+
+ public:
+  static constexpr size_t kBits = Bits;
+
+  constexpr FixedInteger() : digits_{}, is_negative_(false) {
+  }
+
+  constexpr FixedInteger(int64_t value) : digits_{}, is_negative_(value < 0) {  // NOLINT
+    uint64_t abs_val = is_negative_ ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    for (size_t i = 0; i < kDigits && abs_val > 0; ++i) {
+      digits_[i] = static_cast<Digit>(abs_val);
+      abs_val >>= kDigitBits;
+    }
+    if (abs_val != 0) {
+      throw BigIntegerOverflow{};
+    }
+    CheckOverflow();
+  }
+
+  // Throws BigIntegerOverflow when value needs more than Bits bits.
+  explicit FixedInteger(const BigInteger& value) : FixedInteger() {
+    const DigitBuffer& digits = value.digits_;
+    if (value.BitLength() > Bits) {
+      throw BigIntegerOverflow{};
+    }
+    for (size_t i = 0; i < digits.Size() && i < kDigits; ++i) {
+      digits_[i] = digits[i];
+    }
+    is_negative_ = value.is_negative_;
+  }
+
+  explicit FixedInteger(const std::string& str) : FixedInteger(BigInteger(str)) {
+  }
+
+  template <typename T, typename = std::enable_if_t<std::is_same_v<T, const char*>>>
+  explicit FixedInteger(T c_str) : FixedInteger(std::string(c_str)) {
+  }
+
+  // Resizing between widths; narrowing throws BigIntegerOverflow when the value does not fit.
+  template <size_t OtherBits>
+  constexpr explicit FixedInteger(const FixedInteger<OtherBits>& other) : digits_{}, is_negative_(other.is_negative_) {
+    for (size_t i = 0; i < FixedInteger<OtherBits>::kDigits; ++i) {
+      if (i < kDigits) {
+        digits_[i] = other.digits_[i];
+      } else if (other.digits_[i] != 0) {
+        throw BigIntegerOverflow{};
+      }
+    }
+    CheckOverflow();
+  }
+
+  // Throws BigIntegerOverflow past BigInteger's size cap.
+  explicit operator BigInteger() const {
+    DigitBuffer digits;
+    digits.Resize(kDigits);
+    for (size_t i = 0; i < kDigits; ++i) {
+      digits[i] = digits_[i];
+    }
+    BigInteger res = BigInteger::FromDigits(std::move(digits), is_negative_);
+    res.CheckOverflow();
+    return res;
+  }
+
+  constexpr FixedInteger operator+() const {
+    return *this;
+  }
+
+  constexpr FixedInteger operator-() const {
+    FixedInteger copy = *this;
+    copy.is_negative_ = !is_negative_ && !IsZero();
+    return copy;
+  }
+
+  constexpr FixedInteger& operator+=(const FixedInteger& other) {
+    if (is_negative_ == other.is_negative_) {
+      AddMagnitude(other);
+      CheckOverflow();
+    } else if (CompareMagnitude(*this, other) >= 0) {
+      SubtractMagnitude(other);
+    } else {
+      SubtractFromMagnitude(other);
+      is_negative_ = other.is_negative_;
+    }
+    if (IsZero()) {
+      is_negative_ = false;
+    }
+    return *this;
+  }
+
+  constexpr FixedInteger operator+(const FixedInteger& other) const {
+    FixedInteger res = *this;
+    res += other;
+    return res;
+  }
+
+  constexpr FixedInteger& operator-=(const FixedInteger& other) {
+    return *this += -other;
+  }
+
+  constexpr FixedInteger operator-(const FixedInteger& other) const {
+    FixedInteger res = *this;
+    res -= other;
+    return res;
+  }
+
+  constexpr FixedInteger& operator*=(const FixedInteger& other) {
+    return *this = *this * other;
+  }
+
+  constexpr FixedInteger operator*(const FixedInteger& other) const {
+    // Schoolbook over all kDigits digits of both factors, so that the trip counts are compile-time
+    // constants, keeping only the columns below kDigits. The product overflows when a column
+    // carries out of the top digit or when two nonzero digits meet at or above kDigits.
+    FixedInteger res;
+    bool overflow = false;
+    for (size_t j = 0; j < kDigits; ++j) {
+      DoubleDigit carry = 0;
+      for (size_t i = 0; i + j < kDigits; ++i) {
+        DoubleDigit cur = static_cast<DoubleDigit>(digits_[i]) * other.digits_[j] + res.digits_[i + j] + carry;
+        res.digits_[i + j] = static_cast<Digit>(cur);
+        carry = cur >> kDigitBits;
+      }
+      Digit high = 0;
+      for (size_t i = kDigits - j; i < kDigits; ++i) {
+        high |= digits_[i];
+      }
+      overflow = overflow || carry != 0 || (high != 0 && other.digits_[j] != 0);
+    }
+    if (overflow) {
+      throw BigIntegerOverflow{};
+    }
+
+    res.is_negative_ = is_negative_ != other.is_negative_ && !res.IsZero();
+    res.CheckOverflow();
+    return res;
+  }
+
+  // Quotient truncated toward zero and the remainder with the sign of a, from a single division.
+  friend std::pair<FixedInteger, FixedInteger> DivMod(const FixedInteger& a, const FixedInteger& b) {
+    size_t n = a.Length();
+    size_t m = b.Length();
+    if (m == 0) {
+      throw BigIntegerDivisionByZero{};
+    }
+    if (CompareMagnitude(a, b) < 0) {
+      return {FixedInteger(), a};
+    }
+
+    FixedInteger quotient;
+    FixedInteger remainder;
+    if (m == 1) {
+      remainder.digits_[0] = big_integer_kernels::DivModDigit(quotient.digits_, a.digits_, n, b.digits_[0]);
+    } else {
+      // Knuth only: Newton division allocates and pays off past kNewtonDivisionThreshold digits.
+      Digit u[kDigits + 1];
+      Digit v[kDigits];
+      big_integer_kernels::DivModKnuth(quotient.digits_, remainder.digits_, a.digits_, n, b.digits_, m, u, v);
+    }
+    quotient.is_negative_ = a.is_negative_ != b.is_negative_ && !quotient.IsZero();
+    remainder.is_negative_ = a.is_negative_ && !remainder.IsZero();
+    return {quotient, remainder};
+  }
+
+  FixedInteger operator/(const FixedInteger& other) const {
+    return DivMod(*this, other).first;
+  }
+
+  FixedInteger& operator/=(const FixedInteger& other) {
+    return *this = *this / other;
+  }
+
+  FixedInteger operator%(const FixedInteger& other) const {
+    return DivMod(*this, other).second;
+  }
+
+  FixedInteger& operator%=(const FixedInteger& other) {
+    return *this = *this % other;
+  }
+
+  constexpr FixedInteger operator~() const {
+    return -*this - FixedInteger(1);
+  }
+
+  constexpr FixedInteger& operator&=(const FixedInteger& other) {
+    return *this = *this & other;
+  }
+
+  constexpr FixedInteger operator&(const FixedInteger& other) const {
+    return Bitwise(*this, other, [](Digit x, Digit y) {
+      return x & y;
+    });
+  }
+
+  constexpr FixedInteger& operator|=(const FixedInteger& other) {
+    return *this = *this | other;
+  }
+
+  constexpr FixedInteger operator|(const FixedInteger& other) const {
+    return Bitwise(*this, other, [](Digit x, Digit y) {
+      return x | y;
+    });
+  }
+
+  constexpr FixedInteger& operator^=(const FixedInteger& other) {
+    return *this = *this ^ other;
+  }
+
+  constexpr FixedInteger operator^(const FixedInteger& other) const {
+    return Bitwise(*this, other, [](Digit x, Digit y) {
+      return x ^ y;
+    });
+  }
+
+  constexpr FixedInteger& operator<<=(size_t shift) {
+    if (IsZero()) {
+      return *this;
+    }
+    if (shift > Bits || BitLength() + shift > Bits) {
+      throw BigIntegerOverflow{};
+    }
+
+    size_t digit_shift = shift / kDigitBits;
+    int bit_shift = static_cast<int>(shift % kDigitBits);
+    for (size_t i = kDigits; i-- > 0;) {
+      Digit high = i >= digit_shift ? digits_[i - digit_shift] : 0;
+      Digit low = i > digit_shift ? digits_[i - digit_shift - 1] : 0;
+      digits_[i] = bit_shift == 0 ? high : (high << bit_shift) | (low >> (kDigitBits - bit_shift));
+    }
+    return *this;
+  }
+
+  constexpr FixedInteger operator<<(size_t shift) const {
+    FixedInteger res = *this;
+    res <<= shift;
+    return res;
+  }
+
+  constexpr FixedInteger& operator>>=(size_t shift) {
+    bool is_negative = is_negative_;
+    bool inexact = false;
+    size_t digit_shift = shift / kDigitBits;
+    int bit_shift = static_cast<int>(shift % kDigitBits);
+
+    for (size_t i = 0; i < kDigits && i <= digit_shift; ++i) {
+      Digit lost = i < digit_shift ? digits_[i] : bit_shift == 0 ? 0 : digits_[i] << (kDigitBits - bit_shift);
+      inexact |= lost != 0;
+    }
+    for (size_t i = 0; i < kDigits; ++i) {
+      Digit low = i + digit_shift < kDigits ? digits_[i + digit_shift] : 0;
+      Digit high = i + digit_shift + 1 < kDigits ? digits_[i + digit_shift + 1] : 0;
+      digits_[i] = bit_shift == 0 ? low : (low >> bit_shift) | (high << (kDigitBits - bit_shift));
+    }
+
+    if (IsZero()) {
+      is_negative_ = false;
+    }
+    // Rounding toward negative infinity takes a negative value one further once bits are lost.
+    if (is_negative && inexact) {
+      --*this;
+    }
+    return *this;
+  }
+
+  constexpr FixedInteger operator>>(size_t shift) const {
+    FixedInteger res = *this;
+    res >>= shift;
+    return res;
+  }
+
+  constexpr FixedInteger& operator++() {
+    return *this += FixedInteger(1);
+  }
+
+  constexpr FixedInteger operator++(int) {
+    FixedInteger copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  constexpr FixedInteger& operator--() {
+    return *this -= FixedInteger(1);
+  }
+
+  constexpr FixedInteger operator--(int) {
+    FixedInteger copy = *this;
+    --*this;
+    return copy;
+  }
+
+  constexpr bool IsNegative() const {
+    return is_negative_;
+  }
+
+  constexpr explicit operator bool() const {
+    return !IsZero();
+  }
+
+  constexpr size_t BitLength() const {
+    size_t n = Length();
+    if (n == 0) {
+      return 0;
+    }
+    size_t bits = (n - 1) * kDigitBits;
+    for (Digit top = digits_[n - 1]; top != 0; top >>= 1) {
+      ++bits;
+    }
+    return bits;
+  }
+
+  constexpr size_t PopCount() const {
+    size_t count = 0;
+    for (size_t i = 0; i < kDigits; ++i) {
+      for (Digit digit = digits_[i]; digit != 0; digit &= digit - 1) {
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  friend constexpr bool operator==(const FixedInteger& a, const FixedInteger& b) {
+    return a.is_negative_ == b.is_negative_ && CompareMagnitude(a, b) == 0;
+  }
+
+  friend constexpr bool operator!=(const FixedInteger& a, const FixedInteger& b) {
+    return !(a == b);
+  }
+
+  friend constexpr bool operator<(const FixedInteger& a, const FixedInteger& b) {
+    if (a.is_negative_ != b.is_negative_) {
+      return a.is_negative_;
+    }
+    int cmp = CompareMagnitude(a, b);
+    return a.is_negative_ ? cmp > 0 : cmp < 0;
+  }
+
+  friend constexpr bool operator<=(const FixedInteger& a, const FixedInteger& b) {
+    return !(b < a);
+  }
+
+  friend constexpr bool operator>(const FixedInteger& a, const FixedInteger& b) {
+    return b < a;
+  }
+
+  friend constexpr bool operator>=(const FixedInteger& a, const FixedInteger& b) {
+    return !(a < b);
+  }
+
+  // Decimal text with the contracts of the BigInteger overloads; FromChars also reports
+  // std::errc::result_out_of_range for values that need more than Bits bits.
+  friend std::to_chars_result ToChars(char* first, char* last, const FixedInteger& value) {
+    return ToChars(first, last, static_cast<BigInteger>(value));
+  }
+
+  friend std::from_chars_result FromChars(const char* first, const char* last, FixedInteger& value) {
+    BigInteger parsed;
+    std::from_chars_result result = FromChars(first, last, parsed);
+    if (result.ec == std::errc{}) {
+      if (parsed.BitLength() > Bits) {
+        result.ec = std::errc::result_out_of_range;
+      } else {
+        value = FixedInteger(parsed);
+      }
+    }
+    return result;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const FixedInteger& num) {
+    return os << static_cast<BigInteger>(num);
+  }
+
+  friend std::istream& operator>>(std::istream& is, FixedInteger& num) {
+    BigInteger value;
+    is >> value;
+    num = FixedInteger(value);
+    return is;
+  }
+};
+
+using Int128 = FixedInteger<128>;
+using Int256 = FixedInteger<256>;
+using Int512 = FixedInteger<512>;
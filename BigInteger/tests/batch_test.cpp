@@ -0,0 +1,92 @@
+// Checks Sum, Dot, Product, Scale and PrefixSums against term-by-term loops over BigInteger
+// operators, on one thread and on four with the parallel threshold lowered so that the inputs
+// are split into chunks. Values mix signs and sizes so that partial sums cross zero.
+
+#include "big_integer.h"
+#include "big_integer_batch.h"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "check.h"
+
+namespace {
+
+using big_integer_test::Check;
+
+BigInteger RandomValue(std::mt19937& rng, size_t max_chars) {
+  size_t chars = 1 + rng() % max_chars;
+  std::string text = rng() % 2 == 0 ? "-" : "";
+  for (size_t i = 0; i < chars; ++i) {
+    text += static_cast<char>('0' + rng() % 10);
+  }
+  return BigInteger(text);
+}
+
+std::vector<BigInteger> RandomValues(std::mt19937& rng, size_t count, size_t max_chars) {
+  std::vector<BigInteger> values;
+  for (size_t i = 0; i < count; ++i) {
+    values.push_back(RandomValue(rng, max_chars));
+  }
+  return values;
+}
+
+void RunCases(std::mt19937& rng) {
+  for (size_t count : {0, 1, 2, 3, 7, 64, 500}) {
+    std::vector<BigInteger> a = RandomValues(rng, count, 200);
+    std::vector<BigInteger> b = RandomValues(rng, count, 200);
+    BigInteger factor = RandomValue(rng, 300);
+
+    BigInteger sum;
+    BigInteger dot;
+    std::vector<BigInteger> scaled;
+    std::vector<BigInteger> prefix;
+    for (size_t i = 0; i < count; ++i) {
+      sum += a[i];
+      dot += a[i] * b[i];
+      scaled.push_back(a[i] * factor);
+      prefix.push_back(sum);
+    }
+    Check(Sum(a) == sum, "Sum");
+    Check(Dot(a, b) == dot, "Dot");
+    Check(Scale(a, factor) == scaled, "Scale");
+    Check(PrefixSums(a) == prefix, "PrefixSums");
+
+    // Products grow quickly; keep them below the decimal size cap.
+    std::vector<BigInteger> small(a.begin(), a.begin() + std::min<size_t>(count, 64));
+    BigInteger product(1);
+    for (const BigInteger& value : small) {
+      product *= value;
+    }
+    Check(Product(small) == product, "Product");
+  }
+
+  bool thrown = false;
+  try {
+    Dot(RandomValues(rng, 3, 10), RandomValues(rng, 4, 10));
+  } catch (const std::invalid_argument&) {
+    thrown = true;
+  }
+  Check(thrown, "Dot of vectors of different lengths");
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(16);
+  RunCases(rng);
+
+  BigInteger::MultiplicationThresholds defaults = BigInteger::GetMultiplicationThresholds();
+  BigInteger::MultiplicationThresholds parallel = defaults;
+  parallel.parallel = 1;
+  BigInteger::SetMultiplicationThresholds(parallel);
+  BigInteger::SetMultiplicationThreads(4);
+  RunCases(rng);
+  BigInteger::SetMultiplicationThreads(1);
+  BigInteger::SetMultiplicationThresholds(defaults);
+
+  return big_integer_test::Finish("batch_test");
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+
+// Harness shared by the BigInteger tests. Every tests/<name>.cpp is a program built by the CMake
+// target <name> and run by ctest: it reports failed checks on stderr and returns Finish().
+namespace big_integer_test {
+
+// Failures past this many are counted but not printed.
+const int kMaxReported = 20;
+
+inline int& Failures() {
+  static int failures = 0;
+  return failures;
+}
+
+// Counts a failure and returns the stream to describe it on, ending with a newline; the stream
+// swallows the text once kMaxReported failures have been printed.
+inline std::ostream& Fail() {
+  static std::ostream discard(nullptr);
+  if (++Failures() > kMaxReported) {
+    return discard;
+  }
+  return std::cerr << "FAILED: ";
+}
+
+inline void Check(bool condition, const char* what) {
+  if (!condition) {
+    Fail() << what << "\n";
+  }
+}
+
+// Exit status for main.
+inline int Finish(const char* name) {
+  if (Failures() != 0) {
+    std::cerr << name << ": " << Failures() << " failed checks\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << name << ": ok\n";
+  return EXIT_SUCCESS;
+}
+
+}  // namespace big_integer_test
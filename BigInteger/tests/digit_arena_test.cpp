@@ -0,0 +1,75 @@
+// Regression test for the power-of-ten cache of decimal parse and print: the cache outlives every
+// caller, so filling it under a ScopedDigitAllocator must not leave its digits in a DigitArena
+// that is later reset and reused.
+
+#include "big_integer.h"
+#include "digit_allocator.h"
+
+#include <sstream>
+#include <string>
+
+#include "check.h"
+
+namespace {
+
+using big_integer_test::Check;
+
+std::string Digits(size_t count, unsigned seed) {
+  std::string text(count, '0');
+  for (size_t i = 0; i < count; ++i) {
+    seed = seed * 1103515245 + 12345;
+    text[i] = static_cast<char>('0' + (seed >> 16) % 10);
+  }
+  text[0] = '7';
+  return text;
+}
+
+std::string Print(const BigInteger& value) {
+  std::ostringstream os;
+  os << value;
+  return os.str();
+}
+
+BigInteger PowerOfTen(size_t exponent) {
+  BigInteger result(1);
+  for (size_t i = 0; i < exponent; ++i) {
+    result *= 10;
+  }
+  return result;
+}
+
+}  // namespace
+
+int main() {
+  DigitArena arena;
+
+  // The first decimal conversions of the process fill the cache while the arena is installed.
+  {
+    ScopedDigitAllocator scope(arena);
+    std::string text = Digits(5000, 1);
+    Check(Print(BigInteger(text)) == text, "round trip inside the arena");
+  }
+
+  // Reuse the arena so that anything left in it is overwritten.
+  arena.Reset();
+  {
+    ScopedDigitAllocator scope(arena);
+    BigInteger filler(Digits(3000, 2));
+    for (int i = 0; i < 2; ++i) {
+      filler *= filler;
+    }
+    Check(filler > BigInteger(0), "filler");
+  }
+  arena.Reset();
+
+  // Outside the arena the cached powers must still be intact.
+  std::string text = Digits(5000, 3);
+  Check(Print(BigInteger(text)) == text, "round trip after the arena was reused");
+  Check(BigInteger("1" + std::string(4000, '0')) == PowerOfTen(4000), "parse of a power of ten");
+  Check(Print(PowerOfTen(4000)) == "1" + std::string(4000, '0'), "print of a power of ten");
+
+  std::string longer = Digits(25000, 4);
+  Check(Print(BigInteger(longer)) == longer, "round trip that grows the cache");
+
+  return big_integer_test::Finish("digit_arena_test");
+}
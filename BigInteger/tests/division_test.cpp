@@ -0,0 +1,159 @@
+// Checks the division tiers: DivModKnuth against the identity a = q * b + r with r < b, and
+// DivModNewton and the DivMod dispatch against DivModKnuth, with Newton division also run under
+// forced multiplication thresholds so that its products go through every tier. Operands are
+// biased towards 0 and 0xFFFFFFFF digits, which drive Algorithm D into its correction steps.
+
+#include "big_integer_kernels.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "check.h"
+
+namespace {
+
+using big_integer_kernels::Digit;
+using big_integer_kernels::MultiplicationThresholds;
+
+const size_t kNever = std::numeric_limits<size_t>::max();
+const int kCases = 200;
+
+std::vector<Digit> RandomDigits(std::mt19937& rng, size_t n) {
+  std::vector<Digit> digits(n);
+  for (Digit& d : digits) {
+    switch (rng() % 4) {
+      case 0:
+        d = 0;
+        break;
+      case 1:
+        d = ~Digit{0};
+        break;
+      default:
+        d = static_cast<Digit>(rng());
+    }
+  }
+  if (n != 0 && digits[n - 1] == 0) {
+    digits[n - 1] = 1;
+  }
+  return digits;
+}
+
+// A divisor with the top bit set and little below it, or with a small top digit, the two ends of
+// the normalising shift.
+std::vector<Digit> RandomDivisor(std::mt19937& rng, size_t m) {
+  std::vector<Digit> b = RandomDigits(rng, m);
+  switch (rng() % 4) {
+    case 0:
+      b[m - 1] = Digit{1} << 31;
+      break;
+    case 1:
+      b[m - 1] = 1;
+      break;
+    default:
+      break;
+  }
+  return b;
+}
+
+// q and r satisfy a = q * b + r and r < b.
+bool Divides(const std::vector<Digit>& a, const std::vector<Digit>& b, const std::vector<Digit>& q,
+             const std::vector<Digit>& r) {
+  size_t n = a.size();
+  size_t m = b.size();
+  if (big_integer_kernels::Compare(r.data(), big_integer_kernels::Normalized(r.data(), m), b.data(), m) >= 0) {
+    return false;
+  }
+  std::vector<Digit> product(q.size() + m + 1, 0);
+  big_integer_kernels::MulSchoolbook(product.data(), q.data(), q.size(), b.data(), m);
+  big_integer_kernels::AddInPlace(product.data(), product.size(), r.data(), m);
+  size_t len = big_integer_kernels::Normalized(product.data(), product.size());
+  return big_integer_kernels::Compare(product.data(), len, a.data(), big_integer_kernels::Normalized(a.data(), n)) == 0;
+}
+
+using Kernel = void (*)(Digit*, Digit*, const Digit*, size_t, const Digit*, size_t);
+
+// Divides a[0, n) by b[0, m) with kernel and DivModKnuth; checks Knuth against the identity and
+// kernel against Knuth.
+void Compare(const char* name, Kernel kernel, const std::vector<Digit>& a, const std::vector<Digit>& b) {
+  size_t n = a.size();
+  size_t m = b.size();
+  std::vector<Digit> expected_q(n - m + 1);
+  std::vector<Digit> expected_r(m);
+  big_integer_kernels::DivModKnuth(expected_q.data(), expected_r.data(), a.data(), n, b.data(), m);
+  if (!Divides(a, b, expected_q, expected_r)) {
+    big_integer_test::Fail() << "DivModKnuth for " << n << " / " << m << "\n";
+    return;
+  }
+
+  std::vector<Digit> q(n - m + 1, 0x5A5A5A5A);
+  std::vector<Digit> r(m, 0x5A5A5A5A);
+  kernel(q.data(), r.data(), a.data(), n, b.data(), m);
+  if (q != expected_q || r != expected_r) {
+    big_integer_test::Fail() << name << " for " << n << " / " << m << "\n";
+  }
+}
+
+void RunCases(const char* name, Kernel kernel, std::mt19937& rng, size_t min_divisor, size_t max_divisor,
+              size_t max_quotient) {
+  for (int i = 0; i < kCases; ++i) {
+    size_t m = min_divisor + rng() % (max_divisor - min_divisor + 1);
+    size_t n = m + rng() % (max_quotient + 1);
+    std::vector<Digit> b = RandomDivisor(rng, m);
+    std::vector<Digit> a = RandomDigits(rng, n);
+    if (i % 4 == 0) {
+      // A multiple of b, so that the remainder is zero, plus b - 1 every other time.
+      std::vector<Digit> q = RandomDigits(rng, n - m + 1);
+      a.assign(q.size() + m, 0);
+      big_integer_kernels::MulSchoolbook(a.data(), q.data(), q.size(), b.data(), m);
+      if (i % 8 == 0) {
+        std::vector<Digit> below = b;
+        big_integer_kernels::SubInPlace(below.data(), m, std::vector<Digit>{1}.data(), 1);
+        big_integer_kernels::AddInPlace(a.data(), a.size(), below.data(), m);
+      }
+      a.resize(std::max(big_integer_kernels::Normalized(a.data(), a.size()), m));
+      if (a.size() < m || big_integer_kernels::Compare(a.data(), a.size(), b.data(), m) < 0) {
+        continue;
+      }
+    }
+    Compare(name, kernel, a, b);
+  }
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(4711);
+  MultiplicationThresholds defaults = big_integer_kernels::Thresholds();
+
+  RunCases("DivModKnuth", big_integer_kernels::DivModKnuth, rng, 2, 60, 60);
+  RunCases("DivModNewton", big_integer_kernels::DivModNewton, rng, 2, 60, 60);
+  RunCases("DivModNewton", big_integer_kernels::DivModNewton, rng, 2, 700, 1200);
+  RunCases("DivMod", big_integer_kernels::DivMod, rng, 2, 1200, 1200);
+
+  const size_t kDigitCases = 50;
+  for (size_t i = 0; i < kDigitCases; ++i) {
+    std::vector<Digit> b = RandomDivisor(rng, 1);
+    std::vector<Digit> a = RandomDigits(rng, 1 + rng() % 100);
+    std::vector<Digit> q(a.size());
+    std::vector<Digit> r(1);
+    r[0] = big_integer_kernels::DivModDigit(q.data(), a.data(), a.size(), b[0]);
+    if (!Divides(a, b, q, r)) {
+      big_integer_test::Fail() << "DivModDigit for " << a.size() << " / 1\n";
+    }
+    std::vector<Digit> dispatched_q(a.size());
+    std::vector<Digit> dispatched_r(1);
+    big_integer_kernels::DivMod(dispatched_q.data(), dispatched_r.data(), a.data(), a.size(), b.data(), 1);
+    if (dispatched_q != q || dispatched_r != r) {
+      big_integer_test::Fail() << "DivMod for " << a.size() << " / 1\n";
+    }
+  }
+
+  // Newton's reciprocal products through the fast multiplication tiers.
+  big_integer_kernels::Thresholds() = {4, 12, 24, kNever};
+  RunCases("DivModNewton over NTT", big_integer_kernels::DivModNewton, rng, 2, 400, 800);
+  big_integer_kernels::Thresholds() = defaults;
+
+  return big_integer_test::Finish("division_test");
+}
@@ -0,0 +1,69 @@
+// Checks FixedInteger multiplication and division against BigInteger at several widths, whole
+// digits and not: results that fit must agree, and products that do not must throw
+// BigIntegerOverflow. Multiplication is also evaluated at compile time.
+
+#include "big_integer.h"
+#include "fixed_integer.h"
+
+#include <random>
+#include <string>
+
+#include "check.h"
+
+namespace {
+
+using big_integer_test::Check;
+
+const int kCases = 3000;
+
+static_assert((FixedInteger<96>(123456789) * FixedInteger<96>(-987654321)).BitLength() == 57,
+              "constexpr multiplication");
+
+// Up to the decimal digits that always fit in Bits bits, either sign.
+std::string RandomText(std::mt19937& rng, size_t bits) {
+  size_t chars = 1 + rng() % (bits * 30 / 100);
+  std::string text = rng() % 2 == 0 ? "-" : "";
+  text += static_cast<char>('1' + rng() % 9);
+  for (size_t i = 1; i < chars; ++i) {
+    text += static_cast<char>('0' + rng() % 10);
+  }
+  return text;
+}
+
+template <size_t Bits>
+void RunCases(std::mt19937& rng) {
+  for (int i = 0; i < kCases; ++i) {
+    std::string a_text = RandomText(rng, Bits);
+    std::string b_text = RandomText(rng, Bits);
+    BigInteger a(a_text);
+    BigInteger b(b_text);
+    FixedInteger<Bits> x(a_text);
+    FixedInteger<Bits> y(b_text);
+
+    BigInteger product = a * b;
+    bool fits = product.BitLength() <= Bits;
+    bool agrees = false;
+    try {
+      FixedInteger<Bits> z = x * y;
+      agrees = fits && BigInteger(z) == product;
+    } catch (const BigIntegerOverflow&) {
+      agrees = !fits;
+    }
+    Check(agrees, "FixedInteger operator*");
+
+    Check(BigInteger(x / y) == a / b && BigInteger(x % y) == a % b, "FixedInteger operator/ and operator%");
+  }
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(17);
+  RunCases<32>(rng);
+  RunCases<64>(rng);
+  RunCases<65>(rng);
+  RunCases<100>(rng);
+  RunCases<256>(rng);
+  RunCases<1000>(rng);
+  return big_integer_test::Finish("fixed_integer_test");
+}
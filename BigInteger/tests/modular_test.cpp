@@ -0,0 +1,117 @@
+// Checks PowMod, MontgomeryContext, Gcd, ExtendedGcd and ModInverse against plain BigInteger
+// arithmetic: square-and-multiply with a % after every step, and Euclid's algorithm. Moduli are
+// odd and even, from one digit to a few dozen, and operands include negative values.
+
+#include "big_integer.h"
+#include "big_integer_modular.h"
+
+#include <random>
+#include <string>
+
+#include "check.h"
+
+namespace {
+
+using big_integer_test::Check;
+
+const int kCases = 200;
+
+// A random value of up to max_chars decimal digits, negative when allowed and chosen so.
+BigInteger RandomValue(std::mt19937& rng, size_t max_chars, bool allow_negative) {
+  size_t chars = 1 + rng() % max_chars;
+  std::string text;
+  if (allow_negative && rng() % 2 == 0) {
+    text += '-';
+  }
+  for (size_t i = 0; i < chars; ++i) {
+    text += static_cast<char>('0' + rng() % 10);
+  }
+  return BigInteger(text);
+}
+
+// x mod |modulus| in [0, |modulus|).
+BigInteger Reduce(const BigInteger& x, const BigInteger& modulus) {
+  BigInteger res = x % modulus;
+  if (res < 0) {
+    res += Abs(modulus);
+  }
+  return res;
+}
+
+BigInteger NaivePowMod(BigInteger base, BigInteger exponent, const BigInteger& modulus) {
+  BigInteger res = Reduce(1, modulus);
+  base = Reduce(base, modulus);
+  while (exponent > 0) {
+    if (exponent % 2 != 0) {
+      res = Reduce(res * base, modulus);
+    }
+    base = Reduce(base * base, modulus);
+    exponent /= 2;
+  }
+  return res;
+}
+
+BigInteger NaiveGcd(BigInteger a, BigInteger b) {
+  a = Abs(a);
+  b = Abs(b);
+  while (b != 0) {
+    a %= b;
+    std::swap(a, b);
+  }
+  return a;
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(99);
+
+  for (int i = 0; i < kCases; ++i) {
+    BigInteger modulus = RandomValue(rng, 1 + i % 300, true);
+    if (modulus == 0) {
+      modulus = 7;
+    }
+    BigInteger base = RandomValue(rng, 400, true);
+    BigInteger exponent = RandomValue(rng, 30, false);
+
+    BigInteger expected = NaivePowMod(base, exponent, modulus);
+    Check(PowMod(base, exponent, modulus) == expected, "PowMod");
+
+    if (Abs(modulus) % 2 != 0) {
+      MontgomeryContext context(modulus);
+      Check(context.PowMod(base, exponent) == expected, "MontgomeryContext::PowMod");
+      BigInteger other = RandomValue(rng, 400, true);
+      Check(context.MulMod(base, other) == Reduce(base * other, modulus), "MontgomeryContext::MulMod");
+    }
+
+    BigInteger a = RandomValue(rng, 1 + i % 300, true);
+    BigInteger b = RandomValue(rng, 1 + (i * 7) % 300, true);
+    BigInteger gcd = NaiveGcd(a, b);
+    Check(Gcd(a, b) == gcd, "Gcd");
+    // A shared factor, so that the gcd is not almost always 1.
+    BigInteger factor = RandomValue(rng, 40, false);
+    Check(Gcd(a * factor, b * factor) == NaiveGcd(a * factor, b * factor), "Gcd with a common factor");
+
+    ExtendedGcdResult extended = ExtendedGcd(a, b);
+    Check(extended.gcd == gcd && a * extended.x + b * extended.y == gcd, "ExtendedGcd");
+
+    if (Abs(modulus) > 1) {
+      if (NaiveGcd(a, modulus) == 1) {
+        BigInteger inverse = ModInverse(a, modulus);
+        Check(inverse >= 0 && inverse < Abs(modulus) && Reduce(a * inverse, modulus) == 1, "ModInverse");
+        Check(PowMod(a, -exponent - 1, modulus) == NaivePowMod(inverse, exponent + 1, modulus),
+              "PowMod with a negative exponent");
+      } else {
+        bool thrown = false;
+        try {
+          ModInverse(a, modulus);
+        } catch (const BigIntegerNotInvertible&) {
+          thrown = true;
+        }
+        Check(thrown, "ModInverse of a value sharing a factor with the modulus");
+      }
+    }
+  }
+
+  return big_integer_test::Finish("modular_test");
+}
@@ -0,0 +1,108 @@
+// Checks every multiplication tier against MulSchoolbook: the Karatsuba, Toom-3 and NTT kernels
+// called directly, and Mul with Thresholds() forced so that each tier, the unbalanced split and
+// the thread pool are reached at small sizes. Operands are random, biased towards 0 and
+// 0xFFFFFFFF digits so that carries run far, and include squares and unbalanced shapes.
+
+#include "big_integer_kernels.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "check.h"
+
+namespace {
+
+using big_integer_kernels::Digit;
+using big_integer_kernels::MultiplicationThresholds;
+
+const size_t kNever = std::numeric_limits<size_t>::max();
+const size_t kMaxLength = 600;
+const int kCases = 150;
+
+std::vector<Digit> RandomDigits(std::mt19937& rng, size_t n) {
+  std::vector<Digit> digits(n);
+  for (Digit& d : digits) {
+    switch (rng() % 4) {
+      case 0:
+        d = 0;
+        break;
+      case 1:
+        d = ~Digit{0};
+        break;
+      default:
+        d = static_cast<Digit>(rng());
+    }
+  }
+  // Mostly a nonzero top digit, as BigInteger passes, but now and then a zero one so that the
+  // normalisation inside the tiers is exercised too.
+  if (n != 0 && rng() % 8 != 0) {
+    digits[n - 1] |= 1;
+  }
+  return digits;
+}
+
+using Kernel = void (*)(Digit*, const Digit*, size_t, const Digit*, size_t);
+
+// Compares kernel with MulSchoolbook on a[0, n) * b[0, m); b == a for a square.
+void Compare(const char* name, Kernel kernel, const std::vector<Digit>& a, const std::vector<Digit>& b) {
+  size_t n = a.size();
+  size_t m = b.size();
+  std::vector<Digit> expected(n + m);
+  big_integer_kernels::MulSchoolbook(expected.data(), a.data(), n, b.data(), m);
+
+  // A guard digit past the end catches writes beyond res[n + m).
+  std::vector<Digit> res(n + m + 1, 0x5A5A5A5A);
+  kernel(res.data(), a.data(), n, &a == &b ? a.data() : b.data(), m);
+  if (!std::equal(expected.begin(), expected.end(), res.begin()) || res[n + m] != 0x5A5A5A5A) {
+    big_integer_test::Fail() << name << " for " << n << " x " << m << (&a == &b ? " (square)" : "") << "\n";
+  }
+}
+
+void RunCases(const char* name, Kernel kernel, std::mt19937& rng, size_t max_length) {
+  for (int i = 0; i < kCases; ++i) {
+    size_t n = 1 + rng() % max_length;
+    // Balanced, unbalanced and square shapes in turn.
+    size_t m = i % 3 == 0 ? std::max<size_t>(1, n - rng() % (n / 8 + 1)) : 1 + rng() % n;
+    std::vector<Digit> a = RandomDigits(rng, n);
+    if (i % 3 == 2) {
+      Compare(name, kernel, a, a);
+    } else {
+      Compare(name, kernel, a, RandomDigits(rng, m));
+    }
+  }
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(2024);
+  MultiplicationThresholds defaults = big_integer_kernels::Thresholds();
+
+  RunCases("MulKaratsuba", big_integer_kernels::MulKaratsuba, rng, kMaxLength);
+  RunCases("MulToom3", big_integer_kernels::MulToom3, rng, kMaxLength);
+  RunCases("MulNtt", big_integer_kernels::MulNtt, rng, kMaxLength);
+
+  // Each tier reached from Mul at small sizes, recursing through the ones below it.
+  const struct {
+    const char* name;
+    MultiplicationThresholds thresholds;
+    size_t threads;
+  } kConfigs[] = {
+      {"Mul, Karatsuba", {4, kNever, kNever, kNever}, 1},
+      {"Mul, Toom-3", {4, 12, kNever, kNever}, 1},
+      {"Mul, NTT", {4, 12, 24, kNever}, 1},
+      {"Mul, parallel Toom-3", {4, 12, kNever, 16}, 4},
+      {"Mul, parallel NTT", {4, 12, 24, 16}, 4},
+  };
+  for (const auto& config : kConfigs) {
+    big_integer_kernels::Thresholds() = config.thresholds;
+    big_integer_kernels::SetThreadCount(config.threads);
+    RunCases(config.name, big_integer_kernels::Mul, rng, kMaxLength);
+  }
+  big_integer_kernels::Thresholds() = defaults;
+  big_integer_kernels::SetThreadCount(1);
+
+  return big_integer_test::Finish("multiplication_test");
+}
@@ -0,0 +1,133 @@
+// Checks the vectorised digit loops of big_integer_simd against the scalar ones at every level
+// the CPU supports: random lengths from 0 up to past several full vectors, including the partial
+// tails, and digits biased towards 0 and 0xFFFFFFFF so that carries and borrows run across lanes
+// and across vectors.
+
+#include "big_integer_simd.h"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "check.h"
+
+namespace {
+
+using big_integer_simd::Digit;
+using big_integer_simd::Level;
+
+const size_t kMaxLength = 100;
+const int kRounds = 2000;
+
+const char* Name(Level level) {
+  switch (level) {
+    case Level::kScalar:
+      return "scalar";
+    case Level::kSse2:
+      return "sse2";
+    case Level::kAvx2:
+      return "avx2";
+  }
+  return "?";
+}
+
+void Check(bool condition, const char* what, Level level, size_t n) {
+  if (!condition) {
+    big_integer_test::Fail() << what << " at " << Name(level) << ", n = " << n << "\n";
+  }
+}
+
+// Mostly 0 and all-ones digits, which make carries and borrows propagate, with some random ones.
+std::vector<Digit> RandomDigits(std::mt19937& rng, size_t n) {
+  std::vector<Digit> digits(n);
+  for (Digit& d : digits) {
+    switch (rng() % 4) {
+      case 0:
+        d = 0;
+        break;
+      case 1:
+        d = ~Digit{0};
+        break;
+      default:
+        d = static_cast<Digit>(rng());
+    }
+  }
+  return digits;
+}
+
+// Runs the loops at level and at the scalar level and compares digits and carries.
+void Compare(Level level, const std::vector<Digit>& a, const std::vector<Digit>& b, Digit carry) {
+  size_t n = a.size();
+
+  std::vector<Digit> sum = a;
+  std::vector<Digit> expected_sum = a;
+  big_integer_simd::SetActiveLevel(level);
+  Digit carry_out = big_integer_simd::AddDigits(sum.data(), b.data(), n, carry);
+  big_integer_simd::SetActiveLevel(Level::kScalar);
+  Digit expected_carry = big_integer_simd::AddDigits(expected_sum.data(), b.data(), n, carry);
+  Check(sum == expected_sum, "AddDigits digits", level, n);
+  Check(carry_out == expected_carry, "AddDigits carry", level, n);
+
+  std::vector<Digit> difference = a;
+  std::vector<Digit> expected_difference = a;
+  big_integer_simd::SetActiveLevel(level);
+  Digit borrow_out = big_integer_simd::SubDigits(difference.data(), b.data(), n, carry);
+  big_integer_simd::SetActiveLevel(Level::kScalar);
+  Digit expected_borrow = big_integer_simd::SubDigits(expected_difference.data(), b.data(), n, carry);
+  Check(difference == expected_difference, "SubDigits digits", level, n);
+  Check(borrow_out == expected_borrow, "SubDigits borrow", level, n);
+
+  // In place, a == b.
+  std::vector<Digit> doubled = a;
+  std::vector<Digit> expected_doubled = a;
+  big_integer_simd::SetActiveLevel(level);
+  carry_out = big_integer_simd::AddDigits(doubled.data(), doubled.data(), n, carry);
+  big_integer_simd::SetActiveLevel(Level::kScalar);
+  expected_carry = big_integer_simd::AddDigits(expected_doubled.data(), expected_doubled.data(), n, carry);
+  Check(doubled == expected_doubled, "AddDigits in place digits", level, n);
+  Check(carry_out == expected_carry, "AddDigits in place carry", level, n);
+
+  std::vector<Digit> zeroed = a;
+  big_integer_simd::SetActiveLevel(level);
+  borrow_out = big_integer_simd::SubDigits(zeroed.data(), zeroed.data(), n, carry);
+  Check(zeroed == std::vector<Digit>(n, carry != 0 ? ~Digit{0} : 0), "SubDigits in place digits", level, n);
+  Check(borrow_out == carry, "SubDigits in place borrow", level, n);
+
+  big_integer_simd::SetActiveLevel(level);
+  size_t highest = big_integer_simd::HighestDifference(a.data(), b.data(), n);
+  big_integer_simd::SetActiveLevel(Level::kScalar);
+  Check(highest == big_integer_simd::HighestDifference(a.data(), b.data(), n), "HighestDifference", level, n);
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(12345);
+  Level detected = big_integer_simd::Detected();
+
+  for (int level_index = 0; level_index <= static_cast<int>(detected); ++level_index) {
+    Level level = static_cast<Level>(level_index);
+    for (size_t n = 0; n <= kMaxLength; ++n) {
+      for (Digit carry = 0; carry <= 1; ++carry) {
+        std::vector<Digit> a = RandomDigits(rng, n);
+        Compare(level, a, RandomDigits(rng, n), carry);
+        // Equal operands, and operands differing in one digit, for HighestDifference.
+        std::vector<Digit> b = a;
+        Compare(level, a, b, carry);
+        if (n != 0) {
+          b[rng() % n] ^= Digit{1} << (rng() % 32);
+          Compare(level, a, b, carry);
+        }
+      }
+    }
+    for (int round = 0; round < kRounds; ++round) {
+      size_t n = rng() % (kMaxLength + 1);
+      Compare(level, RandomDigits(rng, n), RandomDigits(rng, n), rng() % 2);
+    }
+    std::cout << "simd_test: checked " << Name(level) << "\n";
+  }
+  big_integer_simd::SetActiveLevel(detected);
+
+  return big_integer_test::Finish("simd_test");
+}
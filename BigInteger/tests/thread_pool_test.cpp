@@ -0,0 +1,124 @@
+// Checks that an exception thrown by a ParallelFor body, on a worker or on the calling thread,
+// comes back out of ParallelFor after every started call has finished and leaves the pool
+// usable, including from nested loops. Then runs a parallel product whose digit allocations on
+// the calling thread fail, which must surface as std::bad_alloc rather than end the process.
+
+#include "big_integer.h"
+#include "digit_allocator.h"
+#include "thread_pool.h"
+
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "check.h"
+
+namespace {
+
+using big_integer_test::Check;
+
+const size_t kThreads = 4;
+const size_t kCount = 1000;
+
+// Fails every allocation once limit have been made.
+class FailingAllocator : public DigitAllocator {
+ public:
+  explicit FailingAllocator(size_t limit) : limit_(limit) {
+  }
+
+  void* Allocate(size_t bytes) override {
+    if (made_++ >= limit_) {
+      throw std::bad_alloc();
+    }
+    return ::operator new(bytes);
+  }
+
+  void Deallocate(void* block, size_t) override {
+    ::operator delete(block);
+  }
+
+ private:
+  size_t limit_;
+  size_t made_ = 0;
+};
+
+// Runs a loop on pool whose body throws at index failing, and reports whether ParallelFor
+// rethrew it with every other call either finished or skipped.
+bool ThrowsThrough(ThreadPool& pool, size_t failing) {
+  std::atomic<size_t> running{0};
+  bool overlapped = false;
+  try {
+    pool.ParallelFor(kCount, [&](size_t i) {
+      ++running;
+      std::this_thread::yield();
+      --running;
+      if (i == failing) {
+        throw std::runtime_error("body " + std::to_string(i));
+      }
+    });
+  } catch (const std::runtime_error& error) {
+    overlapped = running.load() != 0;
+    return !overlapped && error.what() == "body " + std::to_string(failing);
+  }
+  return false;
+}
+
+}  // namespace
+
+int main() {
+  ThreadPool pool(kThreads);
+
+  // Index 0 is claimed by whichever thread comes first, the last ones usually by a worker.
+  for (size_t failing : {size_t{0}, kCount / 2, kCount - 1}) {
+    Check(ThrowsThrough(pool, failing), "exception from a ParallelFor body");
+  }
+
+  std::atomic<size_t> calls{0};
+  pool.ParallelFor(kCount, [&](size_t) {
+    ++calls;
+  });
+  Check(calls.load() == kCount, "ParallelFor after a failed loop");
+
+  bool nested = false;
+  try {
+    pool.ParallelFor(8, [&](size_t i) {
+      pool.ParallelFor(8, [&](size_t j) {
+        if (i == 3 && j == 5) {
+          throw std::runtime_error("nested");
+        }
+      });
+    });
+  } catch (const std::runtime_error&) {
+    nested = true;
+  }
+  Check(nested, "exception from a nested ParallelFor body");
+
+  BigInteger::MultiplicationThresholds defaults = BigInteger::GetMultiplicationThresholds();
+  BigInteger::MultiplicationThresholds parallel = defaults;
+  parallel.parallel = 16;
+  BigInteger::SetMultiplicationThresholds(parallel);
+  BigInteger::SetMultiplicationThreads(kThreads);
+
+  BigInteger a = (BigInteger(1) << 20000) - 12345;
+  BigInteger b = (BigInteger(1) << 19000) - 6789;
+  BigInteger expected = a * b;
+  for (size_t limit : {0, 1, 5, 20, 100}) {
+    bool failed = false;
+    try {
+      FailingAllocator allocator(limit);
+      ScopedDigitAllocator scope(allocator);
+      BigInteger product = a * b;
+      failed = product != expected;
+    } catch (const std::bad_alloc&) {
+    }
+    Check(!failed, "parallel product with failing allocations");
+  }
+  Check(a * b == expected, "parallel product after failed allocations");
+
+  BigInteger::SetMultiplicationThreads(1);
+  BigInteger::SetMultiplicationThresholds(defaults);
+
+  return big_integer_test::Finish("thread_pool_test");
+}
@@ -0,0 +1,51 @@
+// Checks ToChars against operator<< for every buffer length around the exact text length, on
+// values next to powers of ten, where the DecimalWidth() estimate is most often one too high.
+
+#include "big_integer.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "check.h"
+
+namespace {
+
+void CheckBuffers(const BigInteger& value) {
+  std::ostringstream os;
+  os << value;
+  std::string expected = os.str();
+
+  for (size_t length = 0; length <= expected.size() + 2; ++length) {
+    std::vector<char> buffer(length + 1, '#');
+    std::to_chars_result result = ToChars(buffer.data(), buffer.data() + length, value);
+    bool fits = length >= expected.size();
+    bool ok = fits ? result.ec == std::errc{} && result.ptr == buffer.data() + expected.size() &&
+                         std::string(buffer.data(), result.ptr) == expected
+                   : result.ec == std::errc::value_too_large && result.ptr == buffer.data() + length;
+    ok = ok && buffer[length] == '#';
+    if (!ok) {
+      big_integer_test::Fail() << expected.substr(0, 40) << (expected.size() > 40 ? "..." : "") << " ("
+                               << expected.size() << " chars) into " << length << " chars\n";
+    }
+  }
+}
+
+}  // namespace
+
+int main() {
+  for (int64_t small = -20; small <= 20; ++small) {
+    CheckBuffers(small);
+  }
+
+  BigInteger power(1);
+  for (size_t exponent = 1; exponent <= 700; ++exponent) {
+    power *= 10;
+    for (const BigInteger& value : {power - 1, power, power + 1}) {
+      CheckBuffers(value);
+      CheckBuffers(-value);
+    }
+  }
+
+  return big_integer_test::Finish("to_chars_test");
+}
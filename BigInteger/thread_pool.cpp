@@ -0,0 +1,103 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threads) : stop_(false) {
+  for (size_t i = 1; i < threads; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  job_added_.notify_all();
+
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+size_t ThreadPool::Size() const {
+  return workers_.size() + 1;
+}
+
+void ThreadPool::Work(Job& job) {
+  for (size_t i = job.next.fetch_add(1); i < job.count; i = job.next.fetch_add(1)) {
+    // Every claimed index is counted as done, even a failed or skipped one, so that the caller
+    // still waits for all workers to let go of the job before it goes out of scope.
+    if (!job.failed.load()) {
+      try {
+        (*job.body)(i);
+      } catch (...) {
+        if (!job.failed.exchange(true)) {
+          job.error = std::current_exception();
+        }
+      }
+    }
+    job.done.fetch_add(1);
+  }
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& body) {
+  if (workers_.empty() || count <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      body(i);
+    }
+    return;
+  }
+
+  Job job;
+  job.body = &body;
+  job.count = count;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(&job);
+  }
+  job_added_.notify_all();
+
+  Work(job);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = std::find(jobs_.begin(), jobs_.end(), &job);
+  if (it != jobs_.end()) {
+    jobs_.erase(it);
+  }
+  job_finished_.wait(lock, [&] {
+    return job.done.load() == job.count && job.users == 0;
+  });
+
+  if (job.error) {
+    std::rethrow_exception(job.error);
+  }
+}
+
+void ThreadPool::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    job_added_.wait(lock, [&] {
+      return stop_ || !jobs_.empty();
+    });
+    if (stop_) {
+      return;
+    }
+
+    Job* job = jobs_.front();
+    ++job->users;
+    lock.unlock();
+
+    Work(*job);
+
+    lock.lock();
+    // Every index is claimed now; retire the job so that idle workers stop picking it up.
+    auto it = std::find(jobs_.begin(), jobs_.end(), job);
+    if (it != jobs_.end()) {
+      jobs_.erase(it);
+    }
+    --job->users;
+    job_finished_.notify_all();
+  }
+}
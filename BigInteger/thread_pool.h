@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fork-join pool for the parallel multiplication paths. The calling thread takes part in its
+// own loops, so a loop started from inside another one always makes progress even when every
+// worker is busy, and nested parallelism cannot deadlock.
+class ThreadPool {
+ public:
+  // threads counts the calling thread: ThreadPool(1) starts no workers and runs loops inline.
+  explicit ThreadPool(size_t threads);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  size_t Size() const;
+
+  // Calls body(i) for every i in [0, count) and returns once all calls have finished. If a call
+  // throws, the indices not yet started are skipped and the first exception is rethrown here.
+  void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+ private:
+  struct Job {
+    const std::function<void(size_t)>* body;
+    size_t count;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    // Set by the first call that throws, which then stores its exception.
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    // Workers holding a pointer to the job, guarded by mutex_.
+    size_t users = 0;
+  };
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable job_added_;
+  std::condition_variable job_finished_;
+  // Jobs that may still have unclaimed indices, oldest first.
+  std::deque<Job*> jobs_;
+  bool stop_;
+
+  static void Work(Job& job);
+  void WorkerLoop();
+};
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+
+//===== Монотонная арена =====
+// Раздаёт память из крупных блоков, сдвигая указатель. Освобождение отдельных кусков ничего не
+// делает: вся память становится свободной разом в Reset(), а блоки при этом остаются за ареной
+// и переиспользуются. Удобна для короткоживущих векторов одного запроса. Не потокобезопасна.
+class MonotonicArena {
+public:
+    explicit MonotonicArena(std::size_t block_bytes = std::size_t{1} << 16) : block_bytes_(block_bytes) {
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() {
+        for (const Block& block : blocks_) {
+            ::operator delete(block.data);
+        }
+    }
+
+    void* Allocate(std::size_t bytes, std::size_t alignment) {
+        while (current_ < blocks_.size()) {
+            const Block& block = blocks_[current_];
+            std::size_t offset = AlignUp(offset_, alignment);
+            if (offset <= block.size && bytes <= block.size - offset) {
+                offset_ = offset + bytes;
+                return block.data + offset;
+            }
+            ++current_;
+            offset_ = 0;
+        }
+
+        // Блоки начинаются с выравнивания max_align_t, так что кусок войдёт с начала нового блока.
+        std::size_t size = std::max(block_bytes_, AlignUp(bytes, alignof(std::max_align_t)));
+        blocks_.push_back({static_cast<char*>(::operator new(size)), size});
+        current_ = blocks_.size() - 1;
+        offset_ = bytes;
+        return blocks_.back().data;
+    }
+
+    void Deallocate(void*, std::size_t) noexcept {
+    }
+
+    // Делает недействительным всё, что было выделено.
+    void Reset() noexcept {
+        current_ = 0;
+        offset_ = 0;
+    }
+
+    // Сколько байт занято у глобальной кучи.
+    std::size_t Capacity() const noexcept {
+        std::size_t total = 0;
+        for (const Block& block : blocks_) {
+            total += block.size;
+        }
+        return total;
+    }
+
+private:
+    struct Block {
+        char* data;
+        std::size_t size;
+    };
+
+    static std::size_t AlignUp(std::size_t offset, std::size_t alignment) {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    std::vector<Block> blocks_;
+    std::size_t current_ = 0;
+    std::size_t offset_ = 0;
+    std::size_t block_bytes_;
+};
+
+//===== Пул блоков одного размера =====
+// Хранит свободные блоки block_bytes байт в односвязном списке и нарезает их кусками по
+// blocks_per_chunk штук. Выделение и освобождение занимают O(1). Не потокобезопасен.
+class FixedPool {
+public:
+    explicit FixedPool(std::size_t block_bytes, std::size_t blocks_per_chunk = 64)
+            : block_bytes_(AlignUp(std::max(block_bytes, sizeof(Node)))),
+              blocks_per_chunk_(std::max<std::size_t>(blocks_per_chunk, 1)) {
+    }
+
+    FixedPool(const FixedPool&) = delete;
+    FixedPool& operator=(const FixedPool&) = delete;
+
+    ~FixedPool() {
+        for (char* chunk : chunks_) {
+            ::operator delete(chunk);
+        }
+    }
+
+    std::size_t BlockBytes() const noexcept {
+        return block_bytes_;
+    }
+
+    // Блок выровнен под max_align_t.
+    void* Allocate() {
+        if (free_ == nullptr) {
+            AddChunk();
+        }
+        Node* node = free_;
+        free_ = node->next;
+        return node;
+    }
+
+    void Deallocate(void* block) noexcept {
+        Node* node = static_cast<Node*>(block);
+        node->next = free_;
+        free_ = node;
+    }
+
+private:
+    struct Node {
+        Node* next;
+    };
+
+    static std::size_t AlignUp(std::size_t bytes) {
+        const std::size_t alignment = alignof(std::max_align_t);
+        return (bytes + alignment - 1) / alignment * alignment;
+    }
+
+    void AddChunk() {
+        char* chunk = static_cast<char*>(::operator new(block_bytes_ * blocks_per_chunk_));
+        chunks_.push_back(chunk);
+        for (std::size_t i = blocks_per_chunk_; i-- > 0;) {
+            Deallocate(chunk + i * block_bytes_);
+        }
+    }
+
+    std::size_t block_bytes_;
+    std::size_t blocks_per_chunk_;
+    std::vector<char*> chunks_;
+    Node* free_ = nullptr;
+};
+
+//===== Аллокатор поверх арены =====
+// Как и у std::pmr, аллокатор не переходит к другому контейнеру при копировании, перемещении и
+// обмене: вектор остаётся в той арене, в которой создан. Арена должна пережить все векторы.
+template <class T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(MonotonicArena& arena) noexcept : arena_(&arena) {
+    }
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_) { // NOLINT
+    }
+
+    T* allocate(std::size_t n) { // NOLINT
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept { // NOLINT
+        arena_->Deallocate(p, n * sizeof(T));
+    }
+
+    MonotonicArena& Arena() const noexcept {
+        return *arena_;
+    }
+
+    template <class U>
+    friend bool operator==(const ArenaAllocator& a, const ArenaAllocator<U>& b) noexcept {
+        return a.arena_ == b.arena_;
+    }
+
+    template <class U>
+    friend bool operator!=(const ArenaAllocator& a, const ArenaAllocator<U>& b) noexcept {
+        return !(a == b); // NOLINT
+    }
+
+private:
+    template <class U>
+    friend class ArenaAllocator;
+
+    MonotonicArena* arena_;
+};
+
+//===== Аллокатор поверх пула =====
+// Запросы, помещающиеся в блок пула, обслуживаются из него, остальные уходят в глобальную кучу:
+// вектор растёт в пуле, пока вместимость не превысит размер блока. Передаётся между
+// контейнерами так же, как ArenaAllocator.
+template <class T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "PoolAllocator: over-aligned types are not supported");
+
+    explicit PoolAllocator(FixedPool& pool) noexcept : pool_(&pool) {
+    }
+
+    template <class U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool_) { // NOLINT
+    }
+
+    T* allocate(std::size_t n) { // NOLINT
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        if (n * sizeof(T) <= pool_->BlockBytes()) {
+            return static_cast<T*>(pool_->Allocate());
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept { // NOLINT
+        if (n * sizeof(T) <= pool_->BlockBytes()) {
+            pool_->Deallocate(p);
+        }
+        else {
+            ::operator delete(p);
+        }
+    }
+
+    FixedPool& Pool() const noexcept {
+        return *pool_;
+    }
+
+    template <class U>
+    friend bool operator==(const PoolAllocator& a, const PoolAllocator<U>& b) noexcept {
+        return a.pool_ == b.pool_;
+    }
+
+    template <class U>
+    friend bool operator!=(const PoolAllocator& a, const PoolAllocator<U>& b) noexcept {
+        return !(a == b); // NOLINT
+    }
+
+private:
+    template <class U>
+    friend class PoolAllocator;
+
+    FixedPool* pool_;
+};
@@ -0,0 +1,85 @@
+// Сравнивает Vector<int> и SmallVector<int, 8> на коротких векторах: для каждого размера
+// создаётся много векторов, заполняемых PushBack, и печатаются время и число обращений к
+// operator new на один вектор. До 8 элементов SmallVector не выделяет память вовсе.
+//
+//   small_vector_bench [--vectors=N]
+//
+// Собирается CMake-целью small_vector_bench.
+
+#include "vector.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace {
+
+std::size_t allocations = 0;
+
+// Не даёт компилятору выбросить заполнение векторов.
+long long sink = 0;
+
+struct Result {
+    double ns_per_vector;
+    double allocations_per_vector;
+};
+
+template <class V>
+Result Measure(std::size_t size, std::size_t vectors) {
+    std::size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < vectors; ++i) {
+        V v;
+        for (std::size_t j = 0; j < size; ++j) {
+            v.PushBack(static_cast<int>(i + j));
+        }
+        sink += v.Empty() ? 0 : v.Back();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return {elapsed.count() / static_cast<double>(vectors),
+            static_cast<double>(allocations - before) / static_cast<double>(vectors)};
+}
+
+}  // namespace
+
+void* operator new(std::size_t bytes) {
+    ++allocations;
+    if (void* p = std::malloc(bytes == 0 ? 1 : bytes)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char** argv) {
+    std::size_t vectors = 1000000;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 10, "--vectors=") == 0) {
+            vectors = std::stoul(arg.substr(10));
+        }
+        else {
+            std::fprintf(stderr, "unknown argument %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    std::printf("%6s %18s %14s %22s %14s\n", "size", "Vector ns/vector", "allocs/vector", "SmallVector ns/vector",
+                "allocs/vector");
+    for (std::size_t size : {0, 1, 2, 4, 7, 8, 9, 16, 32}) {
+        Result heap = Measure<Vector<int>>(size, vectors);
+        Result small = Measure<SmallVector<int, 8>>(size, vectors);
+        std::printf("%6zu %18.1f %14.2f %22.1f %14.2f\n", size, heap.ns_per_vector, heap.allocations_per_vector,
+                    small.ns_per_vector, small.allocations_per_vector);
+    }
+    return sink == -1 ? 1 : 0;
+}
@@ -0,0 +1,449 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vector.h"
+
+//===== Вектор в отображённом в память файле =====
+// Элементы лежат прямо в файле, отображённом через mmap, так что открытие занимает O(1) при любом
+// размере данных, а страницы подгружаются ядром по мере обращения. Файл хранит голый массив T
+// без заголовка: Size() при открытии равен длине файла, делённой на sizeof(T).
+//
+// Пока вектор открыт, длина файла равна Capacity() * sizeof(T); рост идёт через ftruncate и
+// mremap. Sync() и деструктор обрезают файл до Size(). После аварийного завершения без Sync() в
+// конце файла могут остаться нулевые элементы запаса.
+//
+// Интерфейс повторяет Vector для тривиально копируемых T. Не потокобезопасен.
+template <class T>
+class MappedVector {
+public:
+    static_assert(std::is_trivially_copyable_v<T>, "MappedVector stores the bytes of T in a file");
+
+    //===== Псевдонимы типов =====
+    using ValueType = T;
+    using Pointer = T*;
+    using ConstPointer = const T*;
+    using Reference = T&;
+    using ConstReference = const T&;
+    using SizeType = std::size_t;
+    using Iterator = T*;
+    using ConstIterator = const T*;
+    using ReverseIterator = std::reverse_iterator<Iterator>;
+    using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+private:
+    //===== Внутреннее состояние =====
+    SizeType size_ = 0;
+    SizeType capacity_ = 0;
+    Pointer data_ = nullptr;
+    int fd_ = -1;
+    std::string path_;
+
+    [[noreturn]] static void ThrowErrno(const char* what) {
+        throw std::system_error(errno, std::generic_category(), std::string("MappedVector: ") + what);
+    }
+
+    //===== Длина файла и отображение =====
+    // Меняет длину файла и отображения на new_capacity элементов. Пустое отображение не создаётся.
+    void Remap(SizeType new_capacity) {
+        // Длина в байтах должна поместиться и в size_t, и в off_t для ftruncate.
+        if (new_capacity > static_cast<std::size_t>(std::numeric_limits<off_t>::max()) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        std::size_t old_bytes = capacity_ * sizeof(T);
+        std::size_t new_bytes = new_capacity * sizeof(T);
+
+        // При уменьшении отображение сжимается раньше файла, при росте файл растёт раньше
+        // отображения: страницы за концом файла дают SIGBUS.
+        if (new_bytes > old_bytes && ::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+            ThrowErrno("ftruncate");
+        }
+
+        void* mapping = nullptr;
+        if (new_bytes == 0) {
+            if (data_ != nullptr) {
+                ::munmap(data_, old_bytes);
+            }
+        }
+        else if (data_ == nullptr) {
+            mapping = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        }
+        else {
+#ifdef MREMAP_MAYMOVE
+            mapping = ::mremap(data_, old_bytes, new_bytes, MREMAP_MAYMOVE);
+#else
+            // Без mremap файл отображается заново, и старое отображение снимается, только если это удалось.
+            mapping = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+            if (mapping != MAP_FAILED) {
+                ::munmap(data_, old_bytes);
+            }
+#endif
+        }
+        if (mapping == MAP_FAILED) {
+            int error = errno;
+            if (new_bytes > old_bytes) {
+                // Старое отображение при ошибке не тронуто; откатываем рост файла.
+                static_cast<void>(::ftruncate(fd_, static_cast<off_t>(old_bytes)));
+            }
+            errno = error;
+            ThrowErrno("mmap");
+        }
+        data_ = static_cast<Pointer>(mapping);
+
+        if (new_bytes < old_bytes && ::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+            capacity_ = new_capacity;
+            ThrowErrno("ftruncate");
+        }
+        capacity_ = new_capacity;
+    }
+
+    //===== Рост вместимости =====
+    // Не меньше страницы и не меньше удвоенной вместимости, чтобы ftruncate и mremap были редки.
+    SizeType GrowthFor(SizeType count) const {
+        if (count > std::numeric_limits<SizeType>::max() - size_) {
+            throw std::bad_array_new_length();
+        }
+        SizeType page = static_cast<SizeType>(::sysconf(_SC_PAGESIZE)) / sizeof(T);
+        return std::max({size_ + count, capacity_ * 2, std::max<SizeType>(page, 1)});
+    }
+
+    void Close() noexcept {
+        if (data_ != nullptr) {
+            ::munmap(data_, capacity_ * sizeof(T));
+            data_ = nullptr;
+        }
+        if (fd_ != -1) {
+            static_cast<void>(::ftruncate(fd_, static_cast<off_t>(size_ * sizeof(T))));
+            ::close(fd_);
+            fd_ = -1;
+        }
+        size_ = capacity_ = 0;
+    }
+
+public:
+    //===== Конструкторы =====
+    // Открывает файл path на чтение и запись, создавая пустой, если его нет.
+    explicit MappedVector(std::string path) : path_(std::move(path)) {
+        fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ == -1) {
+            ThrowErrno("open");
+        }
+
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) {
+            int error = errno;
+            ::close(fd_);
+            errno = error;
+            ThrowErrno("fstat");
+        }
+        SizeType bytes = static_cast<SizeType>(st.st_size);
+        if (bytes % sizeof(T) != 0) {
+            ::close(fd_);
+            throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                    "MappedVector: file size is not a multiple of sizeof(T)");
+        }
+
+        if (bytes > 0) {
+            void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+            if (mapping == MAP_FAILED) {
+                int error = errno;
+                ::close(fd_);
+                errno = error;
+                ThrowErrno("mmap");
+            }
+            data_ = static_cast<Pointer>(mapping);
+        }
+        size_ = capacity_ = bytes / sizeof(T);
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept
+            : size_(std::exchange(other.size_, 0)), capacity_(std::exchange(other.capacity_, 0)),
+              data_(std::exchange(other.data_, nullptr)), fd_(std::exchange(other.fd_, -1)),
+              path_(std::move(other.path_)) {
+    }
+
+    MappedVector& operator=(MappedVector&& other) noexcept {
+        if (this != &other) {
+            Close();
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+            data_ = std::exchange(other.data_, nullptr);
+            fd_ = std::exchange(other.fd_, -1);
+            path_ = std::move(other.path_);
+        }
+        return *this;
+    }
+
+    //===== Деструктор =====
+    // Обрезает файл до Size(); изменённые страницы ядро допишет само, для надёжности нужен Sync().
+    ~MappedVector() {
+        Close();
+    }
+
+    //===== Доступ к элементам =====
+    ConstReference operator[](SizeType id) const {
+        return data_[id];
+    }
+
+    Reference operator[](SizeType id) {
+        return data_[id];
+    }
+
+    ConstReference At(SizeType id) const {
+        if (id >= size_) {
+            throw VectorOutOfRange{};
+        }
+        return data_[id];
+    }
+
+    Reference At(SizeType id) {
+        if (id >= size_) {
+            throw VectorOutOfRange{};
+        }
+        return data_[id];
+    }
+
+    ConstReference Front() const {
+        return data_[0];
+    }
+
+    Reference Front() {
+        return data_[0];
+    }
+
+    ConstReference Back() const {
+        return data_[size_ - 1];
+    }
+
+    Reference Back() {
+        return data_[size_ - 1];
+    }
+
+    ConstPointer Data() const {
+        return data_;
+    }
+
+    Pointer Data() {
+        return data_;
+    }
+
+    //===== Различные методы =====
+    SizeType Size() const {
+        return size_;
+    }
+
+    SizeType Capacity() const {
+        return capacity_;
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    const std::string& Path() const {
+        return path_;
+    }
+
+    void Swap(MappedVector& other) noexcept {
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(data_, other.data_);
+        std::swap(fd_, other.fd_);
+        std::swap(path_, other.path_);
+    }
+
+    void Reserve(SizeType new_cap) {
+        if (new_cap > capacity_) {
+            Remap(new_cap);
+        }
+    }
+
+    // Обрезает файл до Size().
+    void ShrinkToFit() {
+        if (size_ < capacity_) {
+            Remap(size_);
+        }
+    }
+
+    void Clear() noexcept {
+        size_ = 0;
+    }
+
+    void Resize(SizeType new_size) {
+        Resize(new_size, T());
+    }
+
+    void Resize(SizeType new_size, const T& value) {
+        if (new_size > capacity_) {
+            // value может лежать в самом векторе, а Remap его передвинет.
+            T copy = value;
+            Remap(new_size);
+            std::fill(data_ + size_, data_ + new_size, copy);
+        }
+        else if (new_size > size_) {
+            std::fill(data_ + size_, data_ + new_size, value);
+        }
+        size_ = new_size;
+    }
+
+    // Новые элементы не перезаписываются: после роста файла это нули, после Clear() и повторного
+    // роста в пределах Capacity() — прежнее содержимое.
+    void ResizeUninitialized(SizeType new_size) {
+        Reserve(new_size);
+        size_ = new_size;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    template <class... Args>
+    void EmplaceBack(Args&&... args) {
+        // Аргументы могут ссылаться на сам вектор: объект строится до возможного Remap.
+        T value(std::forward<Args>(args)...);
+        if (size_ == capacity_) {
+            Remap(GrowthFor(1));
+        }
+        data_[size_++] = value;
+    }
+
+    void PopBack() {
+        if (size_ > 0) {
+            --size_;
+        }
+    }
+
+    template <class InputIt,
+            class = std::enable_if_t<
+                    std::is_base_of_v<
+                            std::input_iterator_tag,
+                            typename std::iterator_traits<InputIt>::iterator_category
+                    >
+            >
+    >
+    void Append(InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            SizeType count = static_cast<SizeType>(std::distance(first, last));
+            if (count > capacity_ - size_) {
+                if constexpr (std::is_convertible_v<InputIt, ConstPointer>) {
+                    // Источником может быть сам вектор, а Remap его передвинет: запоминаем смещение.
+                    ConstPointer source = first;
+                    if (count > 0 && std::less_equal<ConstPointer>()(data_, source) &&
+                        std::less<ConstPointer>()(source, data_ + size_)) {
+                        SizeType offset = static_cast<SizeType>(source - data_);
+                        Remap(GrowthFor(count));
+                        std::copy(data_ + offset, data_ + offset + count, data_ + size_);
+                        size_ += count;
+                        return;
+                    }
+                }
+                Remap(GrowthFor(count));
+            }
+            std::copy(first, last, data_ + size_);
+            size_ += count;
+        }
+        else {
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+        }
+    }
+
+    template <class Generator>
+    void AppendWith(SizeType count, Generator&& generator) {
+        if (count > capacity_ - size_) {
+            Remap(GrowthFor(count));
+        }
+        for (SizeType i = 0; i < count; ++i) {
+            data_[size_ + i] = generator(i);
+        }
+        size_ += count;
+    }
+
+    //===== Запись на диск =====
+    // Ставит изменённые страницы в очередь на запись и сразу возвращается.
+    void Flush() {
+        if (data_ != nullptr && ::msync(data_, capacity_ * sizeof(T), MS_ASYNC) != 0) {
+            ThrowErrno("msync");
+        }
+    }
+
+    // Обрезает файл до Size() и дожидается, пока данные и длина файла окажутся на диске.
+    void Sync() {
+        ShrinkToFit();
+        if (data_ != nullptr && ::msync(data_, capacity_ * sizeof(T), MS_SYNC) != 0) {
+            ThrowErrno("msync");
+        }
+        if (::fsync(fd_) != 0) {
+            ThrowErrno("fsync");
+        }
+    }
+
+    //===== Итераторы =====
+    Iterator begin() noexcept { // NOLINT
+        return data_;
+    }
+
+    ConstIterator begin() const noexcept { // NOLINT
+        return data_;
+    }
+
+    ConstIterator cbegin() const noexcept { // NOLINT
+        return data_;
+    }
+
+    Iterator end() noexcept { // NOLINT
+        return data_ + size_;
+    }
+
+    ConstIterator end() const noexcept { // NOLINT
+        return data_ + size_;
+    }
+
+    ConstIterator cend() const noexcept { // NOLINT
+        return data_ + size_;
+    }
+
+    ReverseIterator rbegin() noexcept { // NOLINT
+        return ReverseIterator(end());
+    }
+
+    ConstReverseIterator rbegin() const noexcept { // NOLINT
+        return ConstReverseIterator(end());
+    }
+
+    ConstReverseIterator crbegin() const noexcept { // NOLINT
+        return ConstReverseIterator(cend());
+    }
+
+    ReverseIterator rend() noexcept { // NOLINT
+        return ReverseIterator(begin());
+    }
+
+    ConstReverseIterator rend() const noexcept { // NOLINT
+        return ConstReverseIterator(begin());
+    }
+
+    ConstReverseIterator crend() const noexcept { // NOLINT
+        return ConstReverseIterator(cbegin());
+    }
+};
@@ -0,0 +1,177 @@
+// Проверяет, что копирование, перемещение и обмен Vector следуют propagate_on_container_* его
+// аллокатора: с распространением аллокатор переходит вместе с содержимым, без него остаётся на
+// месте, а элементы переносятся в память своего вектора. Каждый буфер должен вернуться тому
+// аллокатору, который его выдал. То же для SmallVector, у которого часть элементов встроена, и
+// для ArenaAllocator поверх разных арен.
+
+#include "allocators.h"
+#include "vector.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "check.h"
+
+namespace {
+
+using vector_test::Check;
+
+// Кто выдал каждый живой буфер.
+std::map<const void*, int>& Owners() {
+    static std::map<const void*, int> owners;
+    return owners;
+}
+
+// Аллокатор с меткой; с kPropagate = true переходит при копировании, перемещении и обмене.
+template <class T, bool kPropagate>
+class TaggedAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::bool_constant<kPropagate>;
+    using propagate_on_container_move_assignment = std::bool_constant<kPropagate>;
+    using propagate_on_container_swap = std::bool_constant<kPropagate>;
+
+    explicit TaggedAllocator(int tag) noexcept : tag_(tag) {
+    }
+
+    template <class U>
+    TaggedAllocator(const TaggedAllocator<U, kPropagate>& other) noexcept : tag_(other.Tag()) { // NOLINT
+    }
+
+    T* allocate(std::size_t n) { // NOLINT
+        T* p = std::allocator<T>().allocate(n);
+        Owners()[p] = tag_;
+        return p;
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept { // NOLINT
+        auto it = Owners().find(p);
+        Check(it != Owners().end() && it->second == tag_, "a buffer goes back to the allocator that made it");
+        if (it != Owners().end()) {
+            Owners().erase(it);
+        }
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    int Tag() const noexcept {
+        return tag_;
+    }
+
+    template <class U>
+    friend bool operator==(const TaggedAllocator& a, const TaggedAllocator<U, kPropagate>& b) noexcept {
+        return a.Tag() == b.Tag();
+    }
+
+    template <class U>
+    friend bool operator!=(const TaggedAllocator& a, const TaggedAllocator<U, kPropagate>& b) noexcept {
+        return !(a == b); // NOLINT
+    }
+
+private:
+    int tag_;
+};
+
+template <class V>
+V Make(int tag, int size, char fill) {
+    V v{typename V::AllocatorType(tag)};
+    for (int i = 0; i < size; ++i) {
+        v.PushBack(std::string(30, static_cast<char>(fill + i % 10)));
+    }
+    return v;
+}
+
+template <class V>
+bool Holds(const V& v, int size, char fill) {
+    if (static_cast<int>(v.Size()) != size) {
+        return false;
+    }
+    for (int i = 0; i < size; ++i) {
+        if (v[i] != std::string(30, static_cast<char>(fill + i % 10))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Буфер в куче выдан текущим аллокатором вектора; встроенного буфера в Owners() нет.
+template <class V>
+bool OwnsBuffer(const V& v) {
+    auto it = Owners().find(v.Data());
+    return it == Owners().end() || it->second == v.GetAllocator().Tag();
+}
+
+template <class V, bool kPropagate>
+void RunCases(int small, int large) {
+    for (int a_size : {0, small, large}) {
+        for (int b_size : {0, small, large}) {
+            {
+                V a = Make<V>(1, a_size, 'a');
+                V b = Make<V>(2, b_size, 'k');
+                a = b;
+                Check(a.GetAllocator().Tag() == (kPropagate ? 2 : 1), "copy assignment follows propagation");
+                Check(Holds(a, b_size, 'k') && Holds(b, b_size, 'k'), "copy assignment copies");
+                Check(OwnsBuffer(a), "copy assignment buffer");
+            }
+            {
+                V a = Make<V>(1, a_size, 'a');
+                V b = Make<V>(2, b_size, 'k');
+                a = std::move(b);
+                Check(a.GetAllocator().Tag() == (kPropagate ? 2 : 1), "move assignment follows propagation");
+                Check(Holds(a, b_size, 'k'), "move assignment moves");
+                Check(OwnsBuffer(a) && OwnsBuffer(b), "move assignment buffers");
+            }
+            {
+                V a = Make<V>(1, a_size, 'a');
+                V b = Make<V>(2, b_size, 'k');
+                a.Swap(b);
+                Check(a.GetAllocator().Tag() == (kPropagate ? 2 : 1) && b.GetAllocator().Tag() == (kPropagate ? 1 : 2),
+                      "swap follows propagation");
+                Check(Holds(a, b_size, 'k') && Holds(b, a_size, 'a'), "swap exchanges contents");
+                Check(OwnsBuffer(a) && OwnsBuffer(b), "swap buffers");
+            }
+            {
+                V b = Make<V>(2, b_size, 'k');
+                V a(std::move(b), typename V::AllocatorType(1));
+                Check(a.GetAllocator().Tag() == 1 && Holds(a, b_size, 'k') && OwnsBuffer(a),
+                      "move construction with another allocator");
+            }
+        }
+    }
+}
+
+template <bool kPropagate>
+using Tagged = TaggedAllocator<std::string, kPropagate>;
+
+}  // namespace
+
+int main() {
+    RunCases<Vector<std::string, Tagged<true>>, true>(3, 100);
+    RunCases<Vector<std::string, Tagged<false>>, false>(3, 100);
+    RunCases<SmallVector<std::string, 4, Tagged<true>>, true>(3, 100);
+    RunCases<SmallVector<std::string, 4, Tagged<false>>, false>(3, 100);
+    Check(Owners().empty(), "every buffer is freed");
+
+    // Арены не распространяются: каждый вектор остаётся в своей арене.
+    MonotonicArena first;
+    MonotonicArena second;
+    using ArenaVector = Vector<std::string, ArenaAllocator<std::string>>;
+    ArenaVector a{ArenaAllocator<std::string>(first)};
+    ArenaVector b{ArenaAllocator<std::string>(second)};
+    for (int i = 0; i < 100; ++i) {
+        a.PushBack(std::string(30, 'a'));
+        b.PushBack(std::string(30, 'b'));
+    }
+    a = b;
+    Check(&a.GetAllocator().Arena() == &first && a == b, "copy assignment between arenas");
+    b.PushBack("tail");
+    a.Swap(b);
+    Check(&a.GetAllocator().Arena() == &first && &b.GetAllocator().Arena() == &second, "swap keeps the arenas");
+    Check(a.Size() == 101 && a.Back() == "tail" && b.Size() == 100, "swap between arenas exchanges contents");
+    a = std::move(b);
+    Check(&a.GetAllocator().Arena() == &first && a.Size() == 100 && a.Back() == std::string(30, 'b'),
+          "move assignment between arenas");
+
+    return vector_test::Finish("allocator_test");
+}
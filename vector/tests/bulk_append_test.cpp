@@ -0,0 +1,213 @@
+// Проверяет массовое добавление в Vector: Insert в середину по пути memmove для тривиально
+// перемещаемых типов и по пути rotate для остальных, откат Insert, если копирование бросило,
+// Append собственного диапазона вектора с перевыделением и без, AppendWith и ResizeUninitialized.
+// Результат сравнивается с std::vector.
+
+#include "vector.h"
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "check.h"
+
+namespace {
+
+using vector_test::Check;
+
+// Копирование бросает, когда счётчик доходит до нуля; живые объекты считаются.
+struct Brittle {
+    static inline int copies_left = -1;
+    static inline int alive = 0;
+
+    int value;
+
+    explicit Brittle(int v) : value(v) {
+        ++alive;
+    }
+
+    Brittle(const Brittle& other) : value(other.value) {
+        if (copies_left >= 0 && copies_left-- == 0) {
+            throw std::runtime_error("Brittle");
+        }
+        ++alive;
+    }
+
+    ~Brittle() {
+        --alive;
+    }
+};
+
+}  // namespace
+
+template <>
+struct IsTriviallyRelocatable<Brittle> : std::true_type {
+};
+
+namespace {
+
+int IntValue(int i) {
+    return i * 7 + 1;
+}
+
+std::string StringValue(int i) {
+    return std::string(20, 'x') + std::to_string(i);
+}
+
+template <class V, class T>
+bool Equal(const V& v, const std::vector<T>& expected) {
+    return v.Size() == expected.size() && std::equal(v.begin(), v.end(), expected.begin());
+}
+
+template <class T, class Make>
+void RunInsert(Make make) {
+    const int sizes[] = {0, 1, 5, 8};
+    for (int size : sizes) {
+        for (int at = 0; at <= size; ++at) {
+            for (int count : {0, 1, 3, 9}) {
+                for (bool reserve : {false, true}) {
+                    Vector<T> v;
+                    std::vector<T> expected;
+                    if (reserve) {
+                        v.Reserve(size + count);
+                    }
+                    for (int i = 0; i < size; ++i) {
+                        v.PushBack(make(i));
+                        expected.push_back(make(i));
+                    }
+                    std::vector<T> range;
+                    for (int i = 0; i < count; ++i) {
+                        range.push_back(make(100 + i));
+                    }
+                    auto it = v.Insert(v.begin() + at, range.begin(), range.end());
+                    expected.insert(expected.begin() + at, range.begin(), range.end());
+                    Check(Equal(v, expected), "Insert");
+                    Check(it == v.begin() + at, "Insert returns the first inserted element");
+                }
+            }
+        }
+    }
+}
+
+template <class T, class Make>
+void RunSelfAppend(Make make) {
+    for (int size : {1, 4, 9}) {
+        for (bool reserve : {false, true}) {
+            Vector<T> v;
+            std::vector<T> expected;
+            for (int i = 0; i < size; ++i) {
+                v.PushBack(make(i));
+                expected.push_back(make(i));
+            }
+            if (reserve) {
+                v.Reserve(4 * size);
+            }
+            else {
+                v.ShrinkToFit();
+            }
+            const auto* data = v.Data();
+            v.Append(v.begin(), v.end());
+            std::vector<T> whole(expected.begin(), expected.begin() + size);
+            expected.insert(expected.end(), whole.begin(), whole.end());
+            Check(Equal(v, expected), "Append of the whole vector");
+            Check((v.Data() == data) == reserve, "Append reallocates only without spare capacity");
+
+            v.Append(v.begin() + 1, v.begin() + size);
+            std::vector<T> part(expected.begin() + 1, expected.begin() + size);
+            expected.insert(expected.end(), part.begin(), part.end());
+            Check(Equal(v, expected), "Append of a part of the vector");
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    RunInsert<int>(IntValue);
+    RunInsert<std::string>(StringValue);
+    RunSelfAppend<int>(IntValue);
+    RunSelfAppend<std::string>(StringValue);
+
+    {
+        // Однопроходный диапазон идёт через Append и rotate даже для int.
+        Vector<int> v = {1, 2, 3, 4};
+        std::istringstream in("10 20 30");
+        v.Insert(v.begin() + 2, std::istream_iterator<int>(in), std::istream_iterator<int>());
+        Check(Equal(v, std::vector<int>{1, 2, 10, 20, 30, 3, 4}), "Insert from an input iterator");
+    }
+
+    for (bool reserve : {false, true}) {
+        for (int fail_at = 0; fail_at < 3; ++fail_at) {
+            {
+                Vector<Brittle> v;
+                if (reserve) {
+                    v.Reserve(16);
+                }
+                for (int i = 0; i < 5; ++i) {
+                    v.EmplaceBack(i);
+                }
+                std::vector<Brittle> range = {Brittle(10), Brittle(11), Brittle(12)};
+                int alive = Brittle::alive;
+                Brittle::copies_left = fail_at;
+                bool thrown = false;
+                try {
+                    v.Insert(v.begin() + 2, range.begin(), range.end());
+                } catch (const std::runtime_error&) {
+                    thrown = true;
+                }
+                Brittle::copies_left = -1;
+                bool intact = v.Size() == 5;
+                for (int i = 0; intact && i < 5; ++i) {
+                    intact = v[i].value == i;
+                }
+                Check(thrown && intact, "Insert restores the tail when a copy throws");
+                Check(Brittle::alive == alive, "Insert destroys the copies made before the throw");
+            }
+            Check(Brittle::alive == 0, "Insert leaks no elements");
+        }
+    }
+
+    {
+        Vector<std::string> v = {"a", "b"};
+        v.AppendWith(3, [](std::size_t i) {
+            return StringValue(static_cast<int>(i));
+        });
+        Check(Equal(v, std::vector<std::string>{"a", "b", StringValue(0), StringValue(1), StringValue(2)}),
+              "AppendWith");
+
+        bool thrown = false;
+        try {
+            v.AppendWith(10, [](std::size_t i) {
+                if (i == 4) {
+                    throw std::runtime_error("generator");
+                }
+                return StringValue(static_cast<int>(i));
+            });
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        Check(thrown && v.Size() == 5 && v[4] == StringValue(2), "AppendWith keeps the vector when the generator throws");
+    }
+
+    {
+        Vector<int> v = {1, 2, 3};
+        v.ResizeUninitialized(100);
+        Check(v.Size() == 100 && v.Capacity() >= 100 && v[0] == 1 && v[2] == 3, "ResizeUninitialized grows");
+        for (int i = 3; i < 100; ++i) {
+            v[i] = i;
+        }
+        v.ResizeUninitialized(10);
+        Check(v.Size() == 10 && v[9] == 9, "ResizeUninitialized shrinks");
+
+        SmallVector<int, 8> s = {5, 6};
+        s.ResizeUninitialized(8);
+        Check(s.Capacity() == 8 && s[1] == 6, "ResizeUninitialized stays inline");
+        s.ResizeUninitialized(9);
+        Check(s.Capacity() >= 9 && s[0] == 5 && s[1] == 6, "ResizeUninitialized leaves the inline buffer");
+    }
+
+    return vector_test::Finish("bulk_append_test");
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+
+//===== Общая обвязка тестов =====
+// Каждый tests/<name>.cpp собирается CMake-целью <name> и запускается ctest: проваленные
+// проверки печатаются в stderr, а main возвращает Finish().
+namespace vector_test {
+
+// Сверх этого числа провалы считаются, но не печатаются.
+inline constexpr int kMaxReported = 20;
+
+inline int& Failures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void Check(bool condition, const char* what) {
+    if (!condition && ++Failures() <= kMaxReported) {
+        std::cerr << "FAILED: " << what << "\n";
+    }
+}
+
+// Код возврата для main.
+inline int Finish(const char* name) {
+    if (Failures() != 0) {
+        std::cerr << name << ": " << Failures() << " failed checks\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << name << ": ok\n";
+    return EXIT_SUCCESS;
+}
+
+}  // namespace vector_test
@@ -0,0 +1,165 @@
+// Проверяет MappedVector на временном файле: рост через PushBack, Append собственного диапазона с
+// перевыделением, ShrinkToFit и Sync, которые обрезают файл до Size(), повторное открытие с
+// прежним содержимым, сжатие до пустого отображения и отказ от вместимости, не помещающейся в файл.
+
+#include "mapped_vector.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <string>
+#include <system_error>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "check.h"
+
+namespace {
+
+using vector_test::Check;
+
+struct Record {
+    std::uint32_t id;
+    double value;
+};
+
+Record Make(std::size_t i) {
+    return Record{static_cast<std::uint32_t>(i), static_cast<double>(i) * 0.5};
+}
+
+bool Same(const Record& record, std::size_t i) {
+    return record.id == static_cast<std::uint32_t>(i) && record.value == static_cast<double>(i) * 0.5;
+}
+
+// Записи [0, count) равны Make(i % period).
+bool Holds(const MappedVector<Record>& m, std::size_t count, std::size_t period) {
+    if (m.Size() != count) {
+        return false;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!Same(m[i], i % period)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t FileBytes(const std::string& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 ? static_cast<std::size_t>(st.st_size) : ~std::size_t{0};
+}
+
+std::string TempPath() {
+    char path[] = "/tmp/mapped_vector_test.XXXXXX";
+    int fd = ::mkstemp(path);
+    if (fd == -1) {
+        std::abort();
+    }
+    ::close(fd);
+    return path;
+}
+
+}  // namespace
+
+int main() {
+    const std::size_t kCount = 10000;
+    std::string path = TempPath();
+
+    {
+        MappedVector<Record> m(path);
+        Check(m.Empty() && m.Capacity() == 0 && m.Data() == nullptr, "a new file opens empty");
+
+        for (std::size_t i = 0; i < kCount; ++i) {
+            m.PushBack(Make(i));
+        }
+        Check(Holds(m, kCount, kCount), "PushBack through growth");
+        Check(FileBytes(path) == m.Capacity() * sizeof(Record), "an open file spans Capacity()");
+
+        // Ёмкости не хватает: Remap передвигает источник посреди Append.
+        m.ShrinkToFit();
+        Check(m.Capacity() == kCount, "ShrinkToFit");
+        m.Append(m.begin(), m.end());
+        Check(Holds(m, 2 * kCount, kCount), "Append of the whole vector with a remap");
+
+        // Ёмкости хватает: копирование идёт внутри одного отображения.
+        m.Reserve(3 * kCount);
+        m.Append(m.begin(), m.begin() + kCount);
+        Check(Holds(m, 3 * kCount, kCount), "Append of a part of the vector in place");
+
+        m.AppendWith(kCount, [](std::size_t i) {
+            return Make(i);
+        });
+        Check(Holds(m, 4 * kCount, kCount), "AppendWith");
+
+        m.Sync();
+        Check(m.Capacity() == m.Size() && FileBytes(path) == 4 * kCount * sizeof(Record), "Sync trims the file");
+    }
+
+    {
+        MappedVector<Record> m(path);
+        Check(Holds(m, 4 * kCount, kCount), "reopening keeps the records");
+
+        m.Resize(kCount);
+        m.Resize(kCount + 5, Make(7));
+        m.PopBack();
+        Check(m.Size() == kCount + 4 && Same(m[kCount], 7) && Same(m.Back(), 7), "Resize and PopBack");
+        m[0] = Make(42);
+    }
+    Check(FileBytes(path) == (kCount + 4) * sizeof(Record), "the destructor trims the file to Size()");
+
+    {
+        MappedVector<Record> m(path);
+        Check(m.Size() == kCount + 4 && Same(m[0], 42) && Same(m[1], 1), "reopening after a write");
+
+        bool thrown = false;
+        try {
+            m.Reserve(std::numeric_limits<std::size_t>::max() / sizeof(Record) + 1);
+        } catch (const std::bad_array_new_length&) {
+            thrown = true;
+        }
+        Check(thrown, "Reserve beyond the byte size throws");
+
+        thrown = false;
+        try {
+            m.AppendWith(std::numeric_limits<std::size_t>::max() - 1, [](std::size_t i) {
+                return Make(i);
+            });
+        } catch (const std::bad_array_new_length&) {
+            thrown = true;
+        }
+        Check(thrown, "AppendWith beyond the size type throws");
+        Check(m.Size() == kCount + 4 && m.Capacity() == kCount + 4 && Same(m[0], 42), "failed growth keeps the vector");
+
+        m.Clear();
+        m.ShrinkToFit();
+        Check(m.Capacity() == 0 && m.Data() == nullptr && FileBytes(path) == 0, "shrinking to an empty mapping");
+
+        m.PushBack(Make(3));
+        Check(m.Size() == 1 && Same(m[0], 3), "PushBack after shrinking to nothing");
+    }
+
+    {
+        MappedVector<Record> m(path);
+        MappedVector<Record> moved(std::move(m));
+        Check(m.Size() == 0 && moved.Size() == 1 && Same(moved[0], 3), "move construction");
+    }
+
+    {
+        // Длина файла не кратна sizeof(Record): открытие отказывает, файл не трогается.
+        MappedVector<char> bytes(path);
+        bytes.Resize(bytes.Size() + 3, 'x');
+    }
+    std::size_t odd_bytes = FileBytes(path);
+    bool thrown = false;
+    try {
+        MappedVector<Record> m(path);
+    } catch (const std::system_error&) {
+        thrown = true;
+    }
+    Check(thrown && FileBytes(path) == odd_bytes, "a file of a partial record is rejected");
+
+    ::unlink(path.c_str());
+    return vector_test::Finish("mapped_vector_test");
+}
@@ -0,0 +1,126 @@
+// Проверяет рост Vector для тривиально перемещаемых типов: элементы переезжают в новый буфер
+// через memcpy без вызовов конструктора перемещения и деструктора, а для остальных типов —
+// поэлементно, с откатом к старому буферу, если перенос бросил исключение.
+
+#include "vector.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "check.h"
+
+namespace {
+
+using vector_test::Check;
+
+// Считает вызовы особых функций; тривиально перемещаемым объявлен ниже.
+struct Counted {
+    static inline int moves = 0;
+    static inline int destructions = 0;
+
+    int value;
+
+    explicit Counted(int v) : value(v) {
+    }
+
+    Counted(const Counted& other) : value(other.value) {
+    }
+
+    Counted(Counted&& other) noexcept : value(other.value) {
+        ++moves;
+    }
+
+    ~Counted() {
+        ++destructions;
+    }
+};
+
+// Перемещение бросает, когда счётчик доходит до нуля, успев забрать строку.
+struct Fragile {
+    static inline int moves_left = -1;
+
+    std::string value;
+
+    explicit Fragile(std::string v) : value(std::move(v)) {
+    }
+
+    Fragile(const Fragile& other) : value(other.value) {
+    }
+
+    Fragile(Fragile&& other) : value(std::move(other.value)) {
+        if (moves_left >= 0 && moves_left-- == 0) {
+            throw std::runtime_error("Fragile");
+        }
+    }
+};
+
+}  // namespace
+
+template <>
+struct IsTriviallyRelocatable<Counted> : std::true_type {
+};
+
+int main() {
+    {
+        Vector<Counted> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.EmplaceBack(i);
+        }
+        bool values = true;
+        for (int i = 0; i < 1000; ++i) {
+            values = values && v[i].value == i;
+        }
+        Check(values, "Counted keeps its values across growth");
+        Check(Counted::moves == 0, "Counted is relocated without move constructors");
+        Check(Counted::destructions == 0, "Counted is relocated without destructors");
+    }
+    Check(Counted::destructions == 1000, "Counted is destroyed once per element");
+
+    {
+        Vector<std::unique_ptr<int>> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(std::make_unique<int>(i));
+        }
+        v.Reserve(5000);
+        bool values = true;
+        for (int i = 0; i < 1000; ++i) {
+            values = values && *v[i] == i;
+        }
+        Check(values, "unique_ptr keeps its values across growth");
+    }
+
+    {
+        Vector<std::string> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(std::string(40, static_cast<char>('a' + i % 26)));
+        }
+        bool values = true;
+        for (int i = 0; i < 1000; ++i) {
+            values = values && v[i] == std::string(40, static_cast<char>('a' + i % 26));
+        }
+        Check(values, "std::string is moved element by element across growth");
+    }
+
+    {
+        Vector<Fragile> v;
+        v.Reserve(4);
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(std::to_string(i) + std::string(30, '.'));
+        }
+        Fragile::moves_left = 2;
+        bool thrown = false;
+        try {
+            v.EmplaceBack("new");
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        Fragile::moves_left = -1;
+        // Как и std::uninitialized_move, откат не возвращает уже перенесённые значения, но буфер,
+        // размер и не тронутые переносом элементы остаются прежними.
+        bool kept = v.Size() == 4 && v.Capacity() == 4 && v[3].value == "3" + std::string(30, '.');
+        Check(thrown && kept, "a throwing move keeps the old buffer");
+    }
+
+    return vector_test::Finish("relocation_test");
+}
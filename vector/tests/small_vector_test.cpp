@@ -0,0 +1,125 @@
+// Проверяет SmallVector на границе встроенного буфера: копирование, перемещение и обмен векторов
+// всех сочетаний размеров до N, ровно N и больше N — для std::string, которая переносится
+// поэлементно, и для std::unique_ptr, которая переносится через memcpy, — а также возврат во
+// встроенный буфер через ShrinkToFit.
+
+#include "vector.h"
+
+#include <memory>
+#include <string>
+
+#include "check.h"
+
+namespace {
+
+using vector_test::Check;
+
+const std::size_t kInline = 4;
+const int kSizes[] = {0, 1, 3, 4, 5, 20};
+
+template <class V>
+bool IsInline(const V& v) {
+    const char* data = reinterpret_cast<const char*>(v.Data());
+    const char* self = reinterpret_cast<const char*>(&v);
+    return data >= self && data < self + sizeof(v);
+}
+
+std::string Text(int i, char fill) {
+    return std::string(30, fill) + std::to_string(i);
+}
+
+template <class T>
+T Value(int i, char fill);
+
+template <>
+std::string Value<std::string>(int i, char fill) {
+    return Text(i, fill);
+}
+
+template <>
+std::unique_ptr<int> Value<std::unique_ptr<int>>(int i, char fill) {
+    return std::make_unique<int>(fill * 1000 + i);
+}
+
+bool Same(const std::string& value, int i, char fill) {
+    return value == Text(i, fill);
+}
+
+bool Same(const std::unique_ptr<int>& value, int i, char fill) {
+    return value != nullptr && *value == fill * 1000 + i;
+}
+
+template <class T>
+SmallVector<T, kInline> Make(int size, char fill) {
+    SmallVector<T, kInline> v;
+    for (int i = 0; i < size; ++i) {
+        v.PushBack(Value<T>(i, fill));
+    }
+    return v;
+}
+
+template <class T>
+bool Holds(const SmallVector<T, kInline>& v, int size, char fill) {
+    if (static_cast<int>(v.Size()) != size || IsInline(v) != (v.Capacity() == kInline)) {
+        return false;
+    }
+    for (int i = 0; i < size; ++i) {
+        if (!Same(v[i], i, fill)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class T>
+void RunMoves() {
+    for (int a_size : kSizes) {
+        SmallVector<T, kInline> source = Make<T>(a_size, 'a');
+        SmallVector<T, kInline> moved(std::move(source));
+        Check(Holds(moved, a_size, 'a') && source.Empty() && IsInline(source), "move construction");
+        Check(IsInline(moved) == (a_size <= static_cast<int>(kInline)), "move construction keeps small vectors inline");
+
+        for (int b_size : kSizes) {
+            SmallVector<T, kInline> a = Make<T>(a_size, 'a');
+            SmallVector<T, kInline> b = Make<T>(b_size, 'b');
+            a = std::move(b);
+            Check(Holds(a, b_size, 'b') && b.Empty(), "move assignment");
+
+            SmallVector<T, kInline> c = Make<T>(a_size, 'a');
+            SmallVector<T, kInline> d = Make<T>(b_size, 'b');
+            c.Swap(d);
+            Check(Holds(c, b_size, 'b') && Holds(d, a_size, 'a'), "swap");
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    RunMoves<std::string>();
+    RunMoves<std::unique_ptr<int>>();
+
+    for (int a_size : kSizes) {
+        for (int b_size : kSizes) {
+            SmallVector<std::string, kInline> a = Make<std::string>(a_size, 'a');
+            SmallVector<std::string, kInline> b = Make<std::string>(b_size, 'b');
+            SmallVector<std::string, kInline> copy(b);
+            a = b;
+            Check(Holds(a, b_size, 'b') && Holds(copy, b_size, 'b') && Holds(b, b_size, 'b'), "copy");
+        }
+    }
+
+    for (int kept : {0, 2, 4, 5}) {
+        SmallVector<std::string, kInline> v = Make<std::string>(20, 'a');
+        while (static_cast<int>(v.Size()) > kept) {
+            v.PopBack();
+        }
+        v.ShrinkToFit();
+        Check(Holds(v, kept, 'a'), "ShrinkToFit keeps the elements");
+        Check(IsInline(v) == (kept <= static_cast<int>(kInline)), "ShrinkToFit returns to the inline buffer");
+        v.PushBack(Text(kept, 'a'));
+        Check(Holds(v, kept + 1, 'a'), "PushBack after ShrinkToFit");
+    }
+
+    return vector_test::Finish("small_vector_test");
+}
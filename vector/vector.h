@@ -3,6 +3,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
 #include <iterator>
@@ -18,11 +19,60 @@ public:
     }
 };
 
+//===== Признак тривиальной перемещаемости =====
+// Объект такого типа можно перенести в другой буфер побайтовым копированием, не вызывая
+// конструктор перемещения и деструктор старой копии. По умолчанию это тривиально копируемые
+// типы; для своих типов признак включается специализацией:
+//     template <> struct IsTriviallyRelocatable<Record> : std::true_type {};
 template <class T>
-class Vector {
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {
+};
+
+template <class T>
+struct IsTriviallyRelocatable<std::unique_ptr<T>> : std::true_type {
+};
+
+template <class T>
+inline constexpr bool kIsTriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+//===== Встроенный буфер =====
+// Место под N элементов внутри самого объекта. Пустая специализация для N == 0 за счёт
+// оптимизации пустой базы не увеличивает размер обычного Vector.
+template <class T, std::size_t N>
+class VectorInlineBuffer {
+protected:
+    T* InlineData() noexcept {
+        return reinterpret_cast<T*>(bytes_);
+    }
+
+    const T* InlineData() const noexcept {
+        return reinterpret_cast<const T*>(bytes_);
+    }
+
+private:
+    alignas(T) unsigned char bytes_[N * sizeof(T)];
+};
+
+template <class T>
+class VectorInlineBuffer<T, 0> {
+protected:
+    T* InlineData() noexcept {
+        return nullptr;
+    }
+
+    const T* InlineData() const noexcept {
+        return nullptr;
+    }
+};
+
+// При InlineCapacity > 0 первые InlineCapacity элементов хранятся во встроенном буфере, и память
+// у аллокатора берётся, только когда они перестают в него помещаться (см. SmallVector).
+template <class T, class Allocator = std::allocator<T>, std::size_t InlineCapacity = 0>
+class Vector : private VectorInlineBuffer<T, InlineCapacity> {
 public:
     //===== Псевдонимы типов =====
     using ValueType = T;
+    using AllocatorType = Allocator;
     using Pointer = T*;
     using ConstPointer = const T*;
     using Reference = T&;
@@ -34,21 +84,145 @@ public:
     using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
 
 private:
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename AllocatorTraits::value_type, T>, "Allocator::value_type must be T");
+    static_assert(std::is_same_v<typename AllocatorTraits::pointer, T*>, "Allocator must return raw pointers");
+
     //===== Внутреннее состояние =====
     SizeType size_ = 0;
-    SizeType capacity_ = 0;
-    Pointer data_ = nullptr;
-    std::allocator<T> alloc_;
+    SizeType capacity_ = InlineCapacity;
+    Pointer data_ = this->InlineData();
+    Allocator alloc_;
+
+    // disjunction не трогает T при InlineCapacity == 0, так что Vector<Node> можно объявить внутри Node.
+    static constexpr bool kNothrowStorageMove =
+            std::disjunction_v<std::bool_constant<InlineCapacity == 0>, std::is_nothrow_move_constructible<T>>;
+
+    bool IsInline() const noexcept {
+        return InlineCapacity > 0 && data_ == this->InlineData();
+    }
 
     //===== Выделение и освобождение памяти =====
+    // Встроенный буфер отдаётся, только когда в нём нет живых элементов: рост всегда просит больше
+    // InlineCapacity, а ShrinkToFit не трогает встроенный буфер.
     Pointer AllocateStorage(SizeType n) {
-        return n == 0 ? nullptr : alloc_.allocate(n);
+        if (n <= InlineCapacity) {
+            return this->InlineData();
+        }
+        return AllocatorTraits::allocate(alloc_, n);
+    }
+
+    void DeallocateStorage(Pointer p, SizeType n) {
+        if (p && p != this->InlineData()) {
+            AllocatorTraits::deallocate(alloc_, p, n);
+        }
+    }
+
+    //===== Создание и разрушение элементов через аллокатор =====
+    template <class... Args>
+    void ConstructAt(Pointer p, Args&&... args) {
+        AllocatorTraits::construct(alloc_, p, std::forward<Args>(args)...);
+    }
+
+    void DestroyRange(Pointer first, Pointer last) noexcept {
+        for (; first != last; ++first) {
+            AllocatorTraits::destroy(alloc_, first);
+        }
+    }
+
+    // Строит count элементов подряд, начиная с p; при исключении разрушает уже построенные.
+    template <class F>
+    void ConstructRange(Pointer p, SizeType count, F&& construct_one) {
+        SizeType built = 0;
+        try {
+            for (; built < count; ++built) {
+                construct_one(p + built);
+            }
+        } catch (...) {
+            DestroyRange(p, p + built);
+            throw;
+        }
+    }
+
+    // Свой construct аллокатора нельзя обойти memcpy; у std::allocator это просто размещающий new.
+    template <class A>
+    static auto HasConstruct(int)
+            -> decltype(std::declval<A&>().construct(std::declval<T*>(), std::declval<const T&>()), std::true_type());
+
+    template <class A>
+    static std::false_type HasConstruct(...);
+
+    static constexpr bool PlainConstruct() {
+        return std::is_same_v<Allocator, std::allocator<T>> || !decltype(HasConstruct<Allocator>(0))::value;
+    }
+
+    // Копирует count элементов, начиная с first. Тривиально копируемые элементы из обычного
+    // массива переносятся одним memcpy.
+    template <class InputIt>
+    void CopyConstruct(Pointer p, InputIt first, SizeType count) {
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_pointer_v<InputIt> &&
+                      std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIt>>, T> && PlainConstruct()) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(p), static_cast<const void*>(first), count * sizeof(T));
+            }
+        }
+        else {
+            ConstructRange(p, count, [&](Pointer q) {
+                ConstructAt(q, *first);
+                ++first;
+            });
+        }
+    }
+
+    //===== Освобождение всего буфера =====
+    void ReleaseStorage() noexcept {
+        Clear();
+        DeallocateStorage(data_, capacity_);
+        data_ = this->InlineData();
+        capacity_ = InlineCapacity;
+    }
+
+    //===== Перенос буфера из другого вектора =====
+    // *this пуст и без своего буфера, аллокаторы равны. Буфер в куче забирается целиком, элементы
+    // встроенного переносятся по одному; other остаётся пустым.
+    void MoveStorageFrom(Vector& other) noexcept(kNothrowStorageMove) {
+        if (!other.IsInline()) {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.InlineData();
+            other.size_ = 0;
+            other.capacity_ = InlineCapacity;
+            return;
+        }
+        if constexpr (kIsTriviallyRelocatable<T>) {
+            if (other.size_ > 0) {
+                std::memcpy(static_cast<void*>(data_), static_cast<const void*>(other.data_), other.size_ * sizeof(T));
+            }
+        }
+        else {
+            ConstructRange(data_, other.size_, [&](Pointer p) {
+                ConstructAt(p, std::move(other.data_[p - data_]));
+            });
+            other.DestroyRange(other.data_, other.data_ + other.size_);
+        }
+        size_ = other.size_;
+        other.size_ = 0;
     }
 
-    void DeallocateStorage(Pointer p) {
-        if (p) {
-            alloc_.deallocate(p, capacity_);
+    //===== Обмен буферами без аллокаторов =====
+    void SwapStorage(Vector& other) noexcept(kNothrowStorageMove) {
+        if (!IsInline() && !other.IsInline()) {
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+            std::swap(data_, other.data_);
+            return;
         }
+        Vector tmp(alloc_);
+        tmp.MoveStorageFrom(*this);
+        MoveStorageFrom(other);
+        other.MoveStorageFrom(tmp);
     }
 
     //===== Рост вместимости буфера =====
@@ -56,50 +230,77 @@ private:
         return capacity_ == 0 ? 1 : capacity_ * 2;
     }
 
-    //===== Перевыделение памяти с добавлением элемента =====
+    // Вместимость для ещё count элементов: не меньше удвоенной, чтобы серия вставок оставалась
+    // амортизированно линейной.
+    SizeType GrowthFor(SizeType count) const noexcept {
+        return std::max(size_ + count, GrowthFactor());
+    }
+
+    //===== Перевыделение памяти с добавлением элементов =====
+    // placement_logic строит inserted элементов с new_data + size_. Они строятся первыми, пока
+    // старый буфер ещё цел, так что источником может быть сам вектор (PushBack(v[0]), Append(v)).
     template <class F>
-    void ReallocateAndInsert(SizeType new_capacity, F&& placement_logic) {
+    void ReallocateAndInsert(SizeType new_capacity, SizeType inserted, F&& placement_logic) {
         Pointer new_data = AllocateStorage(new_capacity);
         try {
-            std::uninitialized_move(data_, data_ + size_, new_data);
             placement_logic(new_data + size_);
         } catch (...) {
-            std::destroy(new_data, new_data + size_);
-            DeallocateStorage(new_data);
+            DeallocateStorage(new_data, new_capacity);
             throw;
         }
-        std::destroy(data_, data_ + size_);
-        DeallocateStorage(data_);
+        if constexpr (kIsTriviallyRelocatable<T>) {
+            if (size_ > 0) {
+                std::memcpy(static_cast<void*>(new_data), static_cast<const void*>(data_), size_ * sizeof(T));
+            }
+        }
+        else {
+            try {
+                ConstructRange(new_data, size_, [&](Pointer p) {
+                    ConstructAt(p, std::move(data_[p - new_data]));
+                });
+            } catch (...) {
+                DestroyRange(new_data + size_, new_data + size_ + inserted);
+                DeallocateStorage(new_data, new_capacity);
+                throw;
+            }
+            DestroyRange(data_, data_ + size_);
+        }
+        DeallocateStorage(data_, capacity_);
         data_ = new_data;
         capacity_ = new_capacity;
     }
 
     //===== Универсальный конструктор =====
     template <class F>
-    void ConstructWith(SizeType count, F&& constructor_logic) {
-        size_ = capacity_ = count;
+    void ConstructWith(SizeType count, F&& construct_one) {
         data_ = AllocateStorage(count);
         try {
-            constructor_logic(data_, count);
+            ConstructRange(data_, count, construct_one);
         } catch (...) {
-            DeallocateStorage(data_);
+            DeallocateStorage(data_, count);
+            data_ = this->InlineData();
             throw;
         }
+        size_ = count;
+        capacity_ = std::max(count, InlineCapacity);
     }
 
 public:
     //===== Конструкторы =====
     Vector() = default;
 
-    explicit Vector(SizeType size) {
-        ConstructWith(size, [](Pointer p, SizeType n) {
-            std::uninitialized_default_construct_n(p, n);
+    explicit Vector(const Allocator& alloc) : alloc_(alloc) {
+    }
+
+    explicit Vector(SizeType size, const Allocator& alloc = Allocator()) : alloc_(alloc) {
+        ConstructWith(size, [&](Pointer p) {
+            ConstructAt(p);
         });
     }
 
-    Vector(SizeType size, const T& value) {
-        ConstructWith(size, [&](Pointer p, SizeType n) {
-            std::uninitialized_fill_n(p, n, value);
+    Vector(SizeType size, const T& value, const Allocator& alloc = Allocator()) : alloc_(alloc) {
+        ConstructWith(size, [&](Pointer p) {
+            ConstructAt(p, value);
         });
     }
 
@@ -111,50 +312,76 @@ public:
                     >
             >
     >
-    Vector(Iterator first, Iterator last) {
-        ConstructWith(std::distance(first, last), [&](Pointer p, SizeType) {
-            std::uninitialized_copy(first, last, p);
+    Vector(Iterator first, Iterator last, const Allocator& alloc = Allocator()) : alloc_(alloc) {
+        ConstructWith(std::distance(first, last), [&](Pointer p) {
+            ConstructAt(p, *first);
+            ++first;
         });
     }
 
-    Vector(std::initializer_list<T> init) {
-        ConstructWith(init.size(), [&](Pointer p, SizeType) {
-            std::uninitialized_copy(init.begin(), init.end(), p);
-        });
+    Vector(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+            : Vector(init.begin(), init.end(), alloc) {
     }
 
-    Vector(const Vector& other) {
-        ConstructWith(other.size_, [&](Pointer p, SizeType) {
-            std::uninitialized_copy(other.data_, other.data_ + other.size_, p);
-        });
+    Vector(const Vector& other)
+            : Vector(other, AllocatorTraits::select_on_container_copy_construction(other.alloc_)) {
+    }
+
+    Vector(const Vector& other, const Allocator& alloc) : Vector(other.begin(), other.end(), alloc) {
     }
 
-    Vector(Vector&& other) noexcept : size_(other.size_), capacity_(other.capacity_), data_(other.data_) {
-        other.size_ = other.capacity_ = 0;
-        other.data_ = nullptr;
+    Vector(Vector&& other) noexcept(kNothrowStorageMove) : alloc_(std::move(other.alloc_)) {
+        MoveStorageFrom(other);
+    }
+
+    // Буфер забирается, только если alloc может его освободить; иначе элементы переносятся по одному.
+    Vector(Vector&& other, const Allocator& alloc) : alloc_(alloc) {
+        if (alloc_ == other.alloc_) {
+            MoveStorageFrom(other);
+        }
+        else {
+            ConstructWith(other.size_, [&](Pointer p) {
+                ConstructAt(p, std::move(other.data_[p - data_]));
+            });
+        }
     }
 
     //===== Операторы присваивания =====
     Vector& operator=(const Vector& other) {
         if (this != &other) {
-            Vector tmp(other);
-            Swap(tmp);
+            if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value) {
+                // Старый буфер возвращается тому аллокатору, из которого получен.
+                if (alloc_ != other.alloc_) {
+                    ReleaseStorage();
+                }
+                alloc_ = other.alloc_;
+            }
+            Vector tmp(other, alloc_);
+            SwapStorage(tmp);
         }
         return *this;
     }
 
-    Vector& operator=(Vector&& other) noexcept {
+    Vector& operator=(Vector&& other) noexcept(
+            (AllocatorTraits::propagate_on_container_move_assignment::value ||
+             AllocatorTraits::is_always_equal::value) && kNothrowStorageMove) {
         if (this != &other) {
-            Vector temp(std::move(other));
-            Swap(temp);
+            if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+                ReleaseStorage();
+                alloc_ = std::move(other.alloc_);
+                MoveStorageFrom(other);
+            }
+            else {
+                Vector tmp(std::move(other), alloc_);
+                SwapStorage(tmp);
+            }
         }
         return *this;
     }
 
     //===== Деструктор =====
     ~Vector() {
-        Clear();
-        DeallocateStorage(data_);
+        ReleaseStorage();
     }
 
     //===== Доступ к элементам =====
@@ -217,86 +444,109 @@ public:
         return size_ == 0;
     }
 
-    void Swap(Vector& other) {
-        std::swap(size_, other.size_);
-        std::swap(capacity_, other.capacity_);
-        std::swap(data_, other.data_);
+    Allocator GetAllocator() const {
+        return alloc_;
+    }
+
+    // Аллокаторы меняются местами, только если это разрешает propagate_on_container_swap. Иначе
+    // при неравных аллокаторах элементы переносятся по одному, каждый в память своего вектора.
+    void Swap(Vector& other) noexcept(
+            (AllocatorTraits::propagate_on_container_swap::value || AllocatorTraits::is_always_equal::value) &&
+            kNothrowStorageMove) {
+        if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
+        else {
+            if (alloc_ != other.alloc_) {
+                Vector mine(std::move(*this), other.alloc_);
+                Vector theirs(std::move(other), alloc_);
+                SwapStorage(theirs);
+                other.SwapStorage(mine);
+                return;
+            }
+        }
+        SwapStorage(other);
     }
 
     void Reserve(SizeType new_cap) {
         if (new_cap > capacity_) {
-            ReallocateAndInsert(new_cap, [](Pointer) {});
+            ReallocateAndInsert(new_cap, 0, [](Pointer) {});
         }
     }
 
     void ShrinkToFit() {
+        if (IsInline()) {
+            return;
+        }
         if (size_ == 0) {
-            DeallocateStorage(data_);
-            capacity_ = 0;
-            data_ = nullptr;
+            ReleaseStorage();
         }
         else if (size_ < capacity_) {
-            ReallocateAndInsert(size_, [](Pointer) {});
+            ReallocateAndInsert(std::max(size_, InlineCapacity), 0, [](Pointer) {});
         }
     }
 
     void Clear() noexcept {
-        if (data_ != nullptr) {
-            std::destroy(data_, data_ + size_);
-            size_ = 0;
-        }
+        DestroyRange(data_, data_ + size_);
+        size_ = 0;
     }
 
     void Resize(SizeType new_size) {
+        auto construct_default = [&](Pointer p) {
+            ConstructAt(p);
+        };
         if (new_size > capacity_) {
-            ReallocateAndInsert(new_size, [&](Pointer p) {
-                std::uninitialized_default_construct_n(p, new_size - size_);
+            ReallocateAndInsert(new_size, new_size - size_, [&](Pointer p) {
+                ConstructRange(p, new_size - size_, construct_default);
             });
         }
         else if (new_size < size_) {
-            std::destroy(data_ + new_size, data_ + size_);
+            DestroyRange(data_ + new_size, data_ + size_);
         }
         else {
-            std::uninitialized_default_construct_n(data_ + size_, new_size - size_);
+            ConstructRange(data_ + size_, new_size - size_, construct_default);
         }
         size_ = new_size;
     }
 
     void Resize(SizeType new_size, const T& value) {
+        auto construct_copy = [&](Pointer p) {
+            ConstructAt(p, value);
+        };
         if (new_size > capacity_) {
-            ReallocateAndInsert(new_size, [&](Pointer p) {
-                std::uninitialized_fill_n(p, new_size - size_, value);
+            ReallocateAndInsert(new_size, new_size - size_, [&](Pointer p) {
+                ConstructRange(p, new_size - size_, construct_copy);
             });
         }
         else if (new_size < size_) {
-            std::destroy(data_ + new_size, data_ + size_);
+            DestroyRange(data_ + new_size, data_ + size_);
         }
         else {
-            std::uninitialized_fill_n(data_ + size_, new_size - size_, value);
+            ConstructRange(data_ + size_, new_size - size_, construct_copy);
         }
         size_ = new_size;
     }
 
     void PushBack(const T& value) {
         if (size_ == capacity_) {
-            ReallocateAndInsert(GrowthFactor(), [&](Pointer p) {
-                new (p) T(value);
+            ReallocateAndInsert(GrowthFactor(), 1, [&](Pointer p) {
+                ConstructAt(p, value);
             });
         }
         else {
-            new (data_ + size_) T(value);
+            ConstructAt(data_ + size_, value);
         }
         ++size_;
     }
 
     void PushBack(T&& value) {
         if (size_ == capacity_) {
-            ReallocateAndInsert(GrowthFactor(), [&](Pointer p) {
-                new (p) T(std::move(value));
+            ReallocateAndInsert(GrowthFactor(), 1, [&](Pointer p) {
+                ConstructAt(p, std::move(value));
             });
         }
         else {
-            new (data_ + size_) T(std::move(value));
+            ConstructAt(data_ + size_, std::move(value));
         }
         ++size_;
     }
@@ -304,23 +554,124 @@ public:
     template <class... Args>
     void EmplaceBack(Args&&... args) {
         if (size_ == capacity_) {
-            ReallocateAndInsert(GrowthFactor(), [&](Pointer p) {
-                new (p) T(std::forward<Args>(args)...);
+            ReallocateAndInsert(GrowthFactor(), 1, [&](Pointer p) {
+                ConstructAt(p, std::forward<Args>(args)...);
             });
         }
         else {
-            new (data_ + size_) T(std::forward<Args>(args)...);
+            ConstructAt(data_ + size_, std::forward<Args>(args)...);
         }
         ++size_;
     }
 
     void PopBack() {
         if (size_ > 0) {
-            std::destroy_at(data_ + size_ - 1);
+            AllocatorTraits::destroy(alloc_, data_ + size_ - 1);
             --size_;
         }
     }
 
+    //===== Массовое добавление =====
+    // Новые элементы остаются неинициализированными: буфер можно сразу заполнить из read() или
+    // декодера, не записывая сначала нули.
+    void ResizeUninitialized(SizeType new_size) {
+        static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+                      "ResizeUninitialized needs a trivial T");
+        if (new_size > capacity_) {
+            ReallocateAndInsert(new_size, 0, [](Pointer) {});
+        }
+        size_ = new_size;
+    }
+
+    // Для однопроходных итераторов элементы добавляются по одному, иначе память резервируется один раз.
+    template <class InputIt,
+            class = std::enable_if_t<
+                    std::is_base_of_v<
+                            std::input_iterator_tag,
+                            typename std::iterator_traits<InputIt>::iterator_category
+                    >
+            >
+    >
+    void Append(InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            SizeType count = static_cast<SizeType>(std::distance(first, last));
+            if (size_ + count > capacity_) {
+                ReallocateAndInsert(GrowthFor(count), count, [&](Pointer p) {
+                    CopyConstruct(p, first, count);
+                });
+            }
+            else {
+                CopyConstruct(data_ + size_, first, count);
+            }
+            size_ += count;
+        }
+        else {
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+        }
+    }
+
+    // Вставляет [first, last) перед pos и возвращает итератор на первый вставленный элемент.
+    // Диапазон не должен указывать внутрь самого вектора.
+    template <class InputIt,
+            class = std::enable_if_t<
+                    std::is_base_of_v<
+                            std::input_iterator_tag,
+                            typename std::iterator_traits<InputIt>::iterator_category
+                    >
+            >
+    >
+    Iterator Insert(ConstIterator pos, InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        SizeType index = static_cast<SizeType>(pos - data_);
+        if constexpr (kIsTriviallyRelocatable<T> && std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            // Хвост сдвигается одним memmove, и новые элементы строятся прямо на своих местах.
+            SizeType count = static_cast<SizeType>(std::distance(first, last));
+            if (size_ + count > capacity_) {
+                Reserve(GrowthFor(count));
+            }
+            Pointer at = data_ + index;
+            SizeType tail = (size_ - index) * sizeof(T);
+            if (count > 0 && tail > 0) {
+                std::memmove(static_cast<void*>(at + count), static_cast<const void*>(at), tail);
+            }
+            try {
+                CopyConstruct(at, first, count);
+            } catch (...) {
+                if (count > 0 && tail > 0) {
+                    std::memmove(static_cast<void*>(at), static_cast<const void*>(at + count), tail);
+                }
+                throw;
+            }
+            size_ += count;
+        }
+        else {
+            SizeType old_size = size_;
+            Append(first, last);
+            std::rotate(data_ + index, data_ + old_size, data_ + size_);
+        }
+        return data_ + index;
+    }
+
+    // Достраивает count элементов из generator(i), i = 0, ..., count - 1, сразу на их местах.
+    template <class Generator>
+    void AppendWith(SizeType count, Generator&& generator) {
+        auto fill = [&](Pointer start) {
+            ConstructRange(start, count, [&](Pointer p) {
+                ConstructAt(p, generator(static_cast<SizeType>(p - start)));
+            });
+        };
+        if (size_ + count > capacity_) {
+            ReallocateAndInsert(GrowthFor(count), count, fill);
+        }
+        else {
+            fill(data_ + size_);
+        }
+        size_ += count;
+    }
+
     //===== Итераторы =====
     Iterator begin() noexcept { // NOLINT
         return data_;
@@ -394,4 +745,10 @@ public:
     friend bool operator>=(const Vector& a, const Vector& b) {
         return !(a < b); // NOLINT
     }
-};
\ No newline at end of file
+};
+
+//===== Вектор со встроенным буфером =====
+// Тот же Vector, но первые N элементов живут внутри объекта: пока размер не превышает N, память
+// не выделяется вовсе. Перемещение такого вектора переносит встроенные элементы по одному.
+template <class T, std::size_t N, class Allocator = std::allocator<T>>
+using SmallVector = Vector<T, Allocator, N>;